@@ -0,0 +1,123 @@
+using System;
+
+namespace SDF;
+
+/// <summary>
+/// Distances of a static subtree sampled on a regular grid over its bounds and
+/// read back by trilinear interpolation. Values match the subtree at the
+/// samples and are approximate between them; points outside the grid are left
+/// for exact evaluation.
+/// </summary>
+internal sealed class BakedGrid
+{
+    private readonly double _x0, _y0, _z0, _inverseStep, _largest;
+    private readonly int _nx, _ny, _nz;
+    private readonly float[] _values;
+
+    /// <summary>
+    /// Spacing of the samples
+    /// </summary>
+    public double Step { get; }
+
+    private BakedGrid(Vector3 origin, double step, int nx, int ny, int nz, float[] values)
+    {
+        Step = step;
+        _x0 = origin.X;
+        _y0 = origin.Y;
+        _z0 = origin.Z;
+        _inverseStep = 1.0 / step;
+        _nx = nx;
+        _ny = ny;
+        _nz = nz;
+        _values = values;
+        foreach (var value in values)
+            _largest = Math.Max(_largest, Math.Abs((double)value));
+    }
+
+    /// <summary>
+    /// Farthest an interpolated value strays from a subtree changing by at most
+    /// <paramref name="lipschitz"/> per unit of distance around it: each blends
+    /// samples no farther than a cell diagonal away, stored as floats
+    /// </summary>
+    public double Error(double lipschitz) =>
+        lipschitz * Math.Sqrt(3) * Step + _largest / (1 << 23);
+
+    /// <summary>
+    /// Sample <paramref name="node"/> every <paramref name="step"/> over its
+    /// bounds, through <paramref name="kernel"/> when given. Null when the
+    /// bounds are unknown or need more than
+    /// <see cref="TieredEvaluation.MaxBakeSamples"/> samples.
+    /// </summary>
+    public static BakedGrid? Bake(SDF3 node, double step, Func<double, double, double, double>? kernel)
+    {
+        var (x, y, z) = BoundsEvaluator.Evaluate(node);
+        if (!x.IsFinite || !y.IsFinite || !z.IsFinite || BoundsEvaluator.IsEmpty((x, y, z)))
+            return null;
+
+        // Two samples of padding keep the surface and the band around it inside the grid
+        var padding = 2 * step;
+        var origin = new Vector3(x.Lo - padding, y.Lo - padding, z.Lo - padding);
+        long nx = Samples(x, padding, step), ny = Samples(y, padding, step), nz = Samples(z, padding, step);
+        if (nx * ny * nz > TieredEvaluation.MaxBakeSamples)
+            return null;
+
+        var values = new float[nx * ny * nz];
+        var points = new Vector3[ny * nz];
+        for (int i = 0; i < nx; i++)
+        {
+            int idx = 0;
+            for (int j = 0; j < ny; j++)
+            {
+                for (int k = 0; k < nz; k++)
+                {
+                    points[idx++] = new Vector3(origin.X + i * step, origin.Y + j * step, origin.Z + k * step);
+                }
+            }
+
+            var offset = i * points.Length;
+            if (kernel != null)
+            {
+                for (int p = 0; p < points.Length; p++)
+                    values[offset + p] = (float)kernel(points[p].X, points[p].Y, points[p].Z);
+            }
+            else
+            {
+                var slab = Evaluator.Evaluate(node, points);
+                for (int p = 0; p < slab.Length; p++)
+                    values[offset + p] = (float)slab[p];
+            }
+        }
+        return new BakedGrid(origin, step, (int)nx, (int)ny, (int)nz, values);
+    }
+
+    private static long Samples(Interval range, double padding, double step) =>
+        (long)Math.Ceiling((range.Hi - range.Lo + 2 * padding) / step) + 1;
+
+    /// <summary>
+    /// Interpolated distance at (x, y, z), or false when the point lies outside the grid
+    /// </summary>
+    public bool TrySample(double x, double y, double z, out double value)
+    {
+        double fx = (x - _x0) * _inverseStep, fy = (y - _y0) * _inverseStep, fz = (z - _z0) * _inverseStep;
+        // Written so NaN coordinates fall outside too
+        if (!(fx >= 0 && fx <= _nx - 1 && fy >= 0 && fy <= _ny - 1 && fz >= 0 && fz <= _nz - 1))
+        {
+            value = 0;
+            return false;
+        }
+
+        int i = Math.Min((int)fx, _nx - 2), j = Math.Min((int)fy, _ny - 2), k = Math.Min((int)fz, _nz - 2);
+        double tx = fx - i, ty = fy - j, tz = fz - k;
+        int sy = _nz, sx = _ny * _nz;
+        int o = i * sx + j * sy + k;
+        var v = _values;
+        double c00 = v[o] + (v[o + 1] - v[o]) * tz;
+        double c01 = v[o + sy] + (v[o + sy + 1] - v[o + sy]) * tz;
+        double c10 = v[o + sx] + (v[o + sx + 1] - v[o + sx]) * tz;
+        double c11 = v[o + sx + sy] + (v[o + sx + sy + 1] - v[o + sx + sy]) * tz;
+        double c0 = c00 + (c01 - c00) * ty;
+        double c1 = c10 + (c11 - c10) * ty;
+        value = c0 + (c1 - c0) * tx;
+        return true;
+    }
+}
@@ -0,0 +1,205 @@
+using System;
+using System.Buffers.Binary;
+using System.IO;
+using System.Security.Cryptography;
+using System.Threading;
+
+namespace SDF;
+
+/// <summary>
+/// On-disk cache of the mesh of each batch, keyed by a content
+/// hash of the tree pruned to that batch together with the batch's sample
+/// lattice, precision and method. A part edited in one place only invalidates the
+/// batches whose pruned trees changed, so re-exporting a mostly unchanged
+/// assembly reads almost every batch back from disk.
+/// </summary>
+/// <remarks>
+/// Trees with custom leaves have no stable content, so their batches are never
+/// cached. Entries are written to a temporary file and moved into place, so
+/// concurrent writers and interrupted runs cannot leave partial entries.
+/// </remarks>
+public sealed class BatchCache
+{
+    // Part of every key: bump when sampling or meshing output changes
+    private const int FormatVersion = 4;
+    private const uint Magic = 0x42464453; // "SDFB"
+
+    private int _hits;
+    private int _misses;
+
+    public BatchCache(string directory)
+    {
+        Directory = directory;
+        System.IO.Directory.CreateDirectory(directory);
+    }
+
+    /// <summary>
+    /// Directory holding the cache entries
+    /// </summary>
+    public string Directory { get; }
+
+    /// <summary>
+    /// Batches read from the cache since it was created
+    /// </summary>
+    public int Hits => _hits;
+
+    /// <summary>
+    /// Batches that had to be meshed and were then stored
+    /// </summary>
+    public int Misses => _misses;
+
+    /// <summary>
+    /// Delete every entry
+    /// </summary>
+    public void Clear()
+    {
+        foreach (var file in System.IO.Directory.GetFiles(Directory, "*.mesh", SearchOption.AllDirectories))
+            File.Delete(file);
+    }
+
+    /// <summary>
+    /// Key for a batch with origin <paramref name="min"/>, spacing
+    /// <paramref name="step"/> and <paramref name="size"/> samples per axis, or
+    /// null when the tree cannot be cached
+    /// </summary>
+    internal string? Key(SDF3 sdf, Vector3 min, double step, (int x, int y, int z) size, MeshPrecision precision,
+        MeshMethod method)
+    {
+        if (sdf.ContentHash is not { } content)
+            return null;
+
+        using var hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+        var buffer = new byte[8];
+        void Int(int value)
+        {
+            BinaryPrimitives.WriteInt32LittleEndian(buffer, value);
+            hash.AppendData(buffer, 0, 4);
+        }
+        void Double(double value)
+        {
+            BinaryPrimitives.WriteDoubleLittleEndian(buffer, value);
+            hash.AppendData(buffer);
+        }
+
+        Int(FormatVersion);
+        hash.AppendData(content);
+        Double(min.X);
+        Double(min.Y);
+        Double(min.Z);
+        Double(step);
+        Int(size.x);
+        Int(size.y);
+        Int(size.z);
+        Int((int)precision);
+        Int((int)method);
+        return Convert.ToHexString(hash.GetHashAndReset()).ToLowerInvariant();
+    }
+
+    /// <summary>
+    /// Mesh stored under <paramref name="key"/>; unreadable entries count as missing
+    /// </summary>
+    internal bool TryLoad(string key, out BatchMesh mesh)
+    {
+        mesh = null!;
+        var path = EntryPath(key);
+        if (!File.Exists(path))
+            return false;
+        try
+        {
+            using var reader = new BinaryReader(File.OpenRead(path));
+            if (reader.ReadUInt32() != Magic || reader.ReadInt32() != FormatVersion)
+                return false;
+            var vertexCount = reader.ReadInt32();
+            var indexCount = reader.ReadInt32();
+            var result = new BatchMesh(vertexCount, indexCount);
+            for (int i = 0; i < vertexCount; i++)
+            {
+                result.Vertices.Add(new Vector3(reader.ReadDouble(), reader.ReadDouble(), reader.ReadDouble()));
+                result.Keys.Add(reader.ReadInt64());
+            }
+            for (int i = 0; i < indexCount; i++)
+                result.Indices.Add(reader.ReadInt32());
+            mesh = result;
+            Interlocked.Increment(ref _hits);
+            return true;
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            return false;
+        }
+    }
+
+    /// <summary>
+    /// Store a batch's mesh; failures to write leave the cache unchanged
+    /// </summary>
+    internal void Store(string key, BatchMesh? mesh)
+    {
+        Interlocked.Increment(ref _misses);
+        var path = EntryPath(key);
+        var temp = $"{path}.{Guid.NewGuid():N}.tmp";
+        try
+        {
+            System.IO.Directory.CreateDirectory(Path.GetDirectoryName(path)!);
+            using (var writer = new BinaryWriter(File.Create(temp)))
+            {
+                writer.Write(Magic);
+                writer.Write(FormatVersion);
+                writer.Write(mesh?.Vertices.Count ?? 0);
+                writer.Write(mesh?.Indices.Count ?? 0);
+                if (mesh != null)
+                {
+                    for (int i = 0; i < mesh.Vertices.Count; i++)
+                    {
+                        var v = mesh.Vertices[i];
+                        writer.Write(v.X);
+                        writer.Write(v.Y);
+                        writer.Write(v.Z);
+                        writer.Write(mesh.Keys[i]);
+                    }
+                    foreach (var index in mesh.Indices)
+                        writer.Write(index);
+                }
+            }
+            File.Move(temp, path, overwrite: true);
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            File.Delete(temp);
+        }
+    }
+
+    // Entries are spread over subdirectories named by the first byte of the key
+    private string EntryPath(string key) => Path.Combine(Directory, key[..2], key + ".mesh");
+
+    /// <summary>
+    /// SHA-256 of a subtree's kinds, arguments and structure, the same in every
+    /// process, or null when the subtree has custom leaves
+    /// </summary>
+    internal static byte[]? ComputeContentHash(SDF3 node)
+    {
+        if (node.HasCustom)
+            return null;
+
+        using var hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+        Span<byte> buffer = stackalloc byte[8];
+        BinaryPrimitives.WriteInt32LittleEndian(buffer, (int)node.Kind);
+        BinaryPrimitives.WriteInt32LittleEndian(buffer[4..], node.Args.Length);
+        hash.AppendData(buffer);
+        foreach (var arg in node.Args)
+        {
+            BinaryPrimitives.WriteDoubleLittleEndian(buffer, arg);
+            hash.AppendData(buffer);
+        }
+        BinaryPrimitives.WriteInt32LittleEndian(buffer, node.Inputs.Length);
+        hash.AppendData(buffer[..4]);
+        foreach (var child in node.Inputs)
+            hash.AppendData(child.ContentHash!);
+        // Baked subtrees give approximate distances, so they must not share entries with exact ones
+        if (node.BakeStep is { } step)
+        {
+            BinaryPrimitives.WriteDoubleLittleEndian(buffer, step);
+            hash.AppendData(buffer);
+        }
+        return hash.GetHashAndReset();
+    }
+}
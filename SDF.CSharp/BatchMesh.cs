@@ -0,0 +1,48 @@
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Indexed triangles meshed from one batch. Every vertex records where on the
+/// batch's sample lattice it was placed: marching cubes vertices the edge they
+/// were interpolated on, ((x * Ny + y) * Nz + z) * 3 + axis, and dual
+/// contouring vertices their cell, (x * Ny + y) * Nz + z of its lowest sample.
+/// That is how vertices shared with neighboring batches are welded and how
+/// refinement finds the samples around them.
+/// </summary>
+internal sealed class BatchMesh
+{
+    public BatchMesh()
+    {
+        Vertices = new List<Vector3>();
+        Keys = new List<long>();
+        Indices = new List<int>();
+    }
+
+    public BatchMesh(int vertexCount, int indexCount)
+    {
+        Vertices = new List<Vector3>(vertexCount);
+        Keys = new List<long>(vertexCount);
+        Indices = new List<int>(indexCount);
+    }
+
+    public List<Vector3> Vertices { get; }
+    public List<long> Keys { get; }
+
+    /// <summary>
+    /// Three vertex indices per triangle, counterclockwise seen from outside
+    /// </summary>
+    public List<int> Indices { get; }
+
+    public int TriangleCount => Indices.Count / 3;
+
+    /// <summary>
+    /// Append the triangles to <paramref name="triangles"/>, three vertices each
+    /// </summary>
+    public void AppendTriangles(List<Vector3> triangles)
+    {
+        triangles.EnsureCapacity(triangles.Count + Indices.Count);
+        foreach (var index in Indices)
+            triangles.Add(Vertices[index]);
+    }
+}
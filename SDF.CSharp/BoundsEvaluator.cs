@@ -0,0 +1,185 @@
+using System;
+
+namespace SDF;
+
+/// <summary>
+/// Propagates axis-aligned bounding boxes through an SDF3 expression graph.
+/// The box of a node contains every point where its value is at most zero.
+/// Axes a node does not bound are infinite, and a box with Lo > Hi on some
+/// axis is empty.
+/// </summary>
+internal static class BoundsEvaluator
+{
+    private static readonly (Interval x, Interval y, Interval z) Everywhere =
+        (Interval.Entire, Interval.Entire, Interval.Entire);
+
+    public static (Interval x, Interval y, Interval z) Evaluate(SDF3 node)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Custom:
+            case SdfNodeKind.Plane:
+                return Everywhere;
+
+            case SdfNodeKind.Sphere:
+                return Around(Evaluator.Vec(a, 1), new Vector3(a[0], a[0], a[0]));
+            case SdfNodeKind.Box:
+                return Around(Evaluator.Vec(a, 3), Evaluator.Vec(a, 0) / 2.0);
+            case SdfNodeKind.RoundedBox:
+                return Around(Vector3.Zero, Evaluator.Vec(a, 0) / 2.0);
+            case SdfNodeKind.Ellipsoid:
+                return Around(Vector3.Zero, Evaluator.Vec(a, 0));
+            case SdfNodeKind.Cylinder:
+                return (new Interval(-a[0], a[0]), new Interval(-a[0], a[0]), Interval.Entire);
+            case SdfNodeKind.Torus:
+            {
+                var r = a[0] + a[1];
+                return (new Interval(-r, r), new Interval(-r, r), new Interval(-a[1], a[1]));
+            }
+            case SdfNodeKind.CappedCylinder:
+                return Segment(Evaluator.Vec(a, 0), Evaluator.Vec(a, 3), a[6]);
+            case SdfNodeKind.Capsule:
+                return Segment(Evaluator.Vec(a, 0), Evaluator.Vec(a, 3), a[6]);
+
+            case SdfNodeKind.Union:
+                return Hull(Evaluate(node.Inputs[0]), Evaluate(node.Inputs[1]));
+            case SdfNodeKind.SmoothUnion:
+                // The blend lowers min(a, b) by at most k / 4, growing the solid by as much
+                return Expand(Hull(Evaluate(node.Inputs[0]), Evaluate(node.Inputs[1])), a[0] / 4.0);
+            case SdfNodeKind.NaryUnion:
+            {
+                var box = Evaluate(node.Inputs[0]);
+                for (int i = 1; i < node.Inputs.Length; i++)
+                    box = Hull(box, Evaluate(node.Inputs[i]));
+                return Expand(box, a[0] / 4.0);
+            }
+            case SdfNodeKind.Intersection:
+            case SdfNodeKind.SmoothIntersection:
+                return Intersect(Evaluate(node.Inputs[0]), Evaluate(node.Inputs[1]));
+            case SdfNodeKind.Difference:
+            case SdfNodeKind.SmoothDifference:
+                return Evaluate(node.Inputs[0]);
+
+            case SdfNodeKind.Translate:
+            {
+                var (x, y, z) = Evaluate(node.Inputs[0]);
+                return (x + a[0], y + a[1], z + a[2]);
+            }
+            case SdfNodeKind.Scale:
+            {
+                var (x, y, z) = Evaluate(node.Inputs[0]);
+                return (x * a[0], y * a[0], z * a[0]);
+            }
+            case SdfNodeKind.Rotate:
+            {
+                // The child is evaluated at M * p, so the solid is carried by M^T
+                var (x, y, z) = Evaluate(node.Inputs[0]);
+                if (IsEmpty((x, y, z)))
+                    return (x, y, z);
+                Span<double> m = stackalloc double[9];
+                Evaluator.RotationMatrix(a[0], Evaluator.Vec(a, 1), m);
+                return (
+                    x * m[0] + y * m[3] + z * m[6],
+                    x * m[1] + y * m[4] + z * m[7],
+                    x * m[2] + y * m[5] + z * m[8]);
+            }
+            case SdfNodeKind.Affine:
+            {
+                // M is a rotation divided by s, so its inverse is s^2 M^T
+                var (x, y, z) = Evaluate(node.Inputs[0]);
+                if (IsEmpty((x, y, z)))
+                    return (x, y, z);
+                var s2 = a[12] * a[12];
+                x -= a[9];
+                y -= a[10];
+                z -= a[11];
+                return (
+                    (x * a[0] + y * a[3] + z * a[6]) * s2,
+                    (x * a[1] + y * a[4] + z * a[7]) * s2,
+                    (x * a[2] + y * a[5] + z * a[8]) * s2);
+            }
+            case SdfNodeKind.Twist:
+            case SdfNodeKind.Bend:
+            {
+                // Both rotate about Z, keeping the XY radius and Z of every point
+                var (x, y, z) = Evaluate(node.Inputs[0]);
+                if (IsEmpty((x, y, z)))
+                    return (x, y, z);
+                var r = Math.Sqrt(Interval.Square(x).Hi + Interval.Square(y).Hi);
+                return (new Interval(-r, r), new Interval(-r, r), z);
+            }
+            case SdfNodeKind.Elongate:
+            {
+                var (x, y, z) = Evaluate(node.Inputs[0]);
+                return (ElongateAxis(x, a[0]), ElongateAxis(y, a[1]), ElongateAxis(z, a[2]));
+            }
+            case SdfNodeKind.Repeat:
+            {
+                var (x, y, z) = Evaluate(node.Inputs[0]);
+                return (RepeatAxis(x, a[0], a[3]), RepeatAxis(y, a[1], a[4]), RepeatAxis(z, a[2], a[5]));
+            }
+
+            case SdfNodeKind.Dilate:
+            case SdfNodeKind.Shell:
+                return Expand(Evaluate(node.Inputs[0]), a[0]);
+            case SdfNodeKind.Erode:
+                return Evaluate(node.Inputs[0]);
+
+            default:
+                throw new NotSupportedException($"Unknown SDF node kind {node.Kind}");
+        }
+    }
+
+    public static bool IsEmpty((Interval x, Interval y, Interval z) box) =>
+        box.x.Lo > box.x.Hi || box.y.Lo > box.y.Hi || box.z.Lo > box.z.Hi;
+
+    private static (Interval x, Interval y, Interval z) Around(Vector3 center, Vector3 halfSize) => (
+        new Interval(center.X - halfSize.X, center.X + halfSize.X),
+        new Interval(center.Y - halfSize.Y, center.Y + halfSize.Y),
+        new Interval(center.Z - halfSize.Z, center.Z + halfSize.Z));
+
+    private static (Interval x, Interval y, Interval z) Segment(Vector3 a, Vector3 b, double radius) => (
+        new Interval(Math.Min(a.X, b.X) - radius, Math.Max(a.X, b.X) + radius),
+        new Interval(Math.Min(a.Y, b.Y) - radius, Math.Max(a.Y, b.Y) + radius),
+        new Interval(Math.Min(a.Z, b.Z) - radius, Math.Max(a.Z, b.Z) + radius));
+
+    private static (Interval x, Interval y, Interval z) Hull(
+        (Interval x, Interval y, Interval z) a, (Interval x, Interval y, Interval z) b)
+    {
+        if (IsEmpty(a))
+            return b;
+        if (IsEmpty(b))
+            return a;
+        return (Interval.Hull(a.x, b.x), Interval.Hull(a.y, b.y), Interval.Hull(a.z, b.z));
+    }
+
+    private static (Interval x, Interval y, Interval z) Intersect(
+        (Interval x, Interval y, Interval z) a, (Interval x, Interval y, Interval z) b) => (
+        new Interval(Math.Max(a.x.Lo, b.x.Lo), Math.Min(a.x.Hi, b.x.Hi)),
+        new Interval(Math.Max(a.y.Lo, b.y.Lo), Math.Min(a.y.Hi, b.y.Hi)),
+        new Interval(Math.Max(a.z.Lo, b.z.Lo), Math.Min(a.z.Hi, b.z.Hi)));
+
+    private static (Interval x, Interval y, Interval z) Expand((Interval x, Interval y, Interval z) box, double r) =>
+        IsEmpty(box) ? box : (
+            new Interval(box.x.Lo - r, box.x.Hi + r),
+            new Interval(box.y.Lo - r, box.y.Hi + r),
+            new Interval(box.z.Lo - r, box.z.Hi + r));
+
+    /// <summary>
+    /// Points inside the core [-s, s] map to zero and points beyond it are
+    /// moved s closer to it before the child sees them
+    /// </summary>
+    private static Interval ElongateAxis(Interval b, double s) =>
+        b.Lo > b.Hi ? b : new(Math.Min(b.Lo, 0) - s, Math.Max(b.Hi, 0) + s);
+
+    private static Interval RepeatAxis(Interval b, double spacing, double count)
+    {
+        if (b.Lo > b.Hi)
+            return b;
+        var reach = Math.Abs(spacing) * Math.Round(count);
+        if (spacing == 0 || reach == 0)
+            return b;
+        return new Interval(b.Lo - reach, b.Hi + reach);
+    }
+}
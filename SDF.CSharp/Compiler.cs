@@ -0,0 +1,401 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Linq.Expressions;
+using System.Reflection;
+
+namespace SDF;
+
+/// <summary>
+/// Compiles an SDF3 expression graph into a single fused per-point delegate.
+/// Every node is emitted inline into one expression block, so evaluating the
+/// whole tree at a point needs no intermediate arrays and no per-node calls.
+/// </summary>
+internal sealed class Compiler
+{
+    private static readonly MethodInfo SqrtMethod = typeof(Math).GetMethod(nameof(Math.Sqrt), new[] { typeof(double) })!;
+    private static readonly MethodInfo AbsMethod = typeof(Math).GetMethod(nameof(Math.Abs), new[] { typeof(double) })!;
+    private static readonly MethodInfo MinMethod = typeof(Math).GetMethod(nameof(Math.Min), new[] { typeof(double), typeof(double) })!;
+    private static readonly MethodInfo MaxMethod = typeof(Math).GetMethod(nameof(Math.Max), new[] { typeof(double), typeof(double) })!;
+    private static readonly MethodInfo CosMethod = typeof(Math).GetMethod(nameof(Math.Cos), new[] { typeof(double) })!;
+    private static readonly MethodInfo SinMethod = typeof(Math).GetMethod(nameof(Math.Sin), new[] { typeof(double) })!;
+    private static readonly MethodInfo RoundMethod = typeof(Math).GetMethod(nameof(Math.Round), new[] { typeof(double) })!;
+    private static readonly MethodInfo ClampMethod = typeof(Math).GetMethod(nameof(Math.Clamp), new[] { typeof(double), typeof(double), typeof(double) })!;
+    private static readonly MethodInfo BvhEvaluateMethod = typeof(UnionBvh).GetMethod(nameof(UnionBvh.Evaluate),
+        new[] { typeof(double), typeof(double), typeof(double), typeof(double), typeof(Func<double, double, double, double>[]) })!;
+    private static readonly MethodInfo RepeatEvaluateMethod = typeof(RepeatNeighbors).GetMethod(nameof(RepeatNeighbors.Evaluate),
+        new[] { typeof(double), typeof(double), typeof(double), typeof(Func<double, double, double, double>) })!;
+    private static readonly MethodInfo SignMethod = typeof(Math).GetMethod(nameof(Math.Sign), new[] { typeof(double) })!;
+
+    private static readonly Expression Zero = Expression.Constant(0.0);
+    private static readonly Expression One = Expression.Constant(1.0);
+
+    private readonly List<ParameterExpression> _variables = new();
+    private readonly List<Expression> _body = new();
+    private readonly Dictionary<(SDF3, Expression, Expression, Expression), (Expression value, int order)> _emitted = new();
+
+    // Everything the emitted code depends on besides constants and objects:
+    // the kinds emitted, reuses of earlier nodes, and branches taken
+    private readonly List<int> _shape = new();
+
+    // Set when compiling a template kernel, whose constants and objects are
+    // parameters rather than baked into the code
+    private readonly ConcurrentDictionary<string, TemplateKernel>? _templates;
+    private readonly ParameterExpression? _constants;
+    private readonly ParameterExpression? _objects;
+    private readonly List<double> _constantValues = new();
+    private readonly List<object> _objectValues = new();
+
+    /// <summary>
+    /// Kernel shared by every tree of one shape, taking that tree's constants and objects
+    /// </summary>
+    internal delegate double TemplateKernel(double[] constants, object[] objects, double x, double y, double z);
+
+    private Compiler(ConcurrentDictionary<string, TemplateKernel>? templates = null)
+    {
+        _templates = templates;
+        if (templates != null)
+        {
+            _constants = Expression.Parameter(typeof(double[]), "constants");
+            _objects = Expression.Parameter(typeof(object[]), "objects");
+        }
+    }
+
+    /// <summary>
+    /// Compile a tree into a delegate evaluating it at a single point
+    /// </summary>
+    public static Func<double, double, double, double> Compile(SDF3 root)
+    {
+        var x = Expression.Parameter(typeof(double), "x");
+        var y = Expression.Parameter(typeof(double), "y");
+        var z = Expression.Parameter(typeof(double), "z");
+
+        var compiler = new Compiler();
+        var result = compiler.Emit(root, x, y, z);
+        compiler._body.Add(result);
+
+        var block = Expression.Block(typeof(double), compiler._variables, compiler._body);
+        return Expression.Lambda<Func<double, double, double, double>>(block, x, y, z).Compile();
+    }
+
+    /// <summary>
+    /// Compile a tree into a delegate evaluating it at a single point, reusing
+    /// the template kernel of an earlier tree with the same shape. Trees that
+    /// differ only in their arguments, such as variants of a parametric part,
+    /// then pay for emitting the code but not for compiling it.
+    /// </summary>
+    public static Func<double, double, double, double> Compile(SDF3 root, ConcurrentDictionary<string, TemplateKernel> templates)
+    {
+        var x = Expression.Parameter(typeof(double), "x");
+        var y = Expression.Parameter(typeof(double), "y");
+        var z = Expression.Parameter(typeof(double), "z");
+
+        var compiler = new Compiler(templates);
+        var result = compiler.Emit(root, x, y, z);
+        var kernel = templates.GetOrAdd(string.Join(",", compiler._shape), _ =>
+        {
+            compiler._body.Add(result);
+            var block = Expression.Block(typeof(double), compiler._variables, compiler._body);
+            return Expression.Lambda<TemplateKernel>(block, compiler._constants!, compiler._objects!, x, y, z).Compile();
+        });
+
+        var constants = compiler._constantValues.ToArray();
+        var objects = compiler._objectValues.ToArray();
+        return (px, py, pz) => kernel(constants, objects, px, py, pz);
+    }
+
+    /// <summary>
+    /// Emit a node, reusing the variable already holding its value when the same
+    /// node was emitted at the same coordinates. The block is straight-line code,
+    /// so every earlier variable is assigned by the time a later one is read.
+    /// </summary>
+    private Expression Emit(SDF3 node, Expression x, Expression y, Expression z)
+    {
+        if (_emitted.TryGetValue((node, x, y, z), out var emitted))
+        {
+            _shape.Add(-1 - emitted.order);
+            return emitted.value;
+        }
+        _shape.Add((int)node.Kind);
+        var value = EmitNode(node, x, y, z);
+        _emitted[(node, x, y, z)] = (value, _emitted.Count);
+        return value;
+    }
+
+    private Expression EmitNode(SDF3 node, Expression x, Expression y, Expression z)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Custom:
+            {
+                var function = node.Function!;
+                Func<double, double, double, double> single = (px, py, pz) => function(new[] { new Vector3(px, py, pz) })[0];
+                return Let(Expression.Invoke(O(single), x, y, z));
+            }
+
+            case SdfNodeKind.Sphere:
+            {
+                var dx = Let(Sub(x, C(a[1])));
+                var dy = Let(Sub(y, C(a[2])));
+                var dz = Let(Sub(z, C(a[3])));
+                return Let(Sub(Length(dx, dy, dz), C(a[0])));
+            }
+            case SdfNodeKind.Box:
+            {
+                var qx = Let(Sub(Abs(Sub(x, C(a[3]))), C(a[0] / 2.0)));
+                var qy = Let(Sub(Abs(Sub(y, C(a[4]))), C(a[1] / 2.0)));
+                var qz = Let(Sub(Abs(Sub(z, C(a[5]))), C(a[2] / 2.0)));
+                return Let(BoxDistance(qx, qy, qz));
+            }
+            case SdfNodeKind.Cylinder:
+                return Let(Sub(Sqrt(Add(Mul(x, x), Mul(y, y))), C(a[0])));
+            case SdfNodeKind.CappedCylinder:
+            {
+                var pa = Vector3Of(a, 0);
+                var ba = Vector3Of(a, 3) - pa;
+                var baba = Vector3.Dot(ba, ba);
+                var radius = a[6];
+                var pax = Let(Sub(x, C(pa.X)));
+                var pay = Let(Sub(y, C(pa.Y)));
+                var paz = Let(Sub(z, C(pa.Z)));
+                var paba = Let(Dot(pax, pay, paz, ba));
+                var cx = Let(Sub(Mul(pax, C(baba)), Mul(C(ba.X), paba)));
+                var cy = Let(Sub(Mul(pay, C(baba)), Mul(C(ba.Y), paba)));
+                var cz = Let(Sub(Mul(paz, C(baba)), Mul(C(ba.Z), paba)));
+                var qx = Let(Sub(Length(cx, cy, cz), C(radius * baba)));
+                var qy = Let(Sub(Abs(Sub(paba, C(baba * 0.5))), C(baba * 0.5)));
+                var x2 = Let(Mul(qx, qx));
+                var y2 = Let(Mul(Mul(qy, qy), C(baba)));
+                var d = Let(Expression.Condition(
+                    Expression.LessThan(Max(qx, qy), Zero),
+                    Expression.Negate(Min(x2, y2)),
+                    Add(
+                        Expression.Condition(Expression.GreaterThan(qx, Zero), x2, Zero),
+                        Expression.Condition(Expression.GreaterThan(qy, Zero), y2, Zero))));
+                return Let(Div(Mul(Sign(d), Sqrt(Abs(d))), C(baba)));
+            }
+            case SdfNodeKind.Plane:
+                return Let(Add(Add(
+                    Mul(Sub(x, C(a[3])), C(a[0])),
+                    Mul(Sub(y, C(a[4])), C(a[1]))),
+                    Mul(Sub(z, C(a[5])), C(a[2]))));
+            case SdfNodeKind.Torus:
+            {
+                var qx = Let(Sub(Sqrt(Add(Mul(x, x), Mul(y, y))), C(a[0])));
+                return Let(Sub(Sqrt(Add(Mul(qx, qx), Mul(z, z))), C(a[1])));
+            }
+            case SdfNodeKind.RoundedBox:
+            {
+                var radius = a[3];
+                var qx = Let(Sub(Abs(x), C(a[0] / 2.0 - radius)));
+                var qy = Let(Sub(Abs(y), C(a[1] / 2.0 - radius)));
+                var qz = Let(Sub(Abs(z), C(a[2] / 2.0 - radius)));
+                return Let(Sub(BoxDistance(qx, qy, qz), C(radius)));
+            }
+            case SdfNodeKind.Capsule:
+            {
+                var pa = Vector3Of(a, 0);
+                var ba = Vector3Of(a, 3) - pa;
+                var baba = Vector3.Dot(ba, ba);
+                var pax = Let(Sub(x, C(pa.X)));
+                var pay = Let(Sub(y, C(pa.Y)));
+                var paz = Let(Sub(z, C(pa.Z)));
+                var h = Let(Clamp(Div(Dot(pax, pay, paz, ba), C(baba)), Zero, One));
+                var dx = Let(Sub(pax, Mul(C(ba.X), h)));
+                var dy = Let(Sub(pay, Mul(C(ba.Y), h)));
+                var dz = Let(Sub(paz, Mul(C(ba.Z), h)));
+                return Let(Sub(Length(dx, dy, dz), C(a[6])));
+            }
+            case SdfNodeKind.Ellipsoid:
+            {
+                var k0x = Let(Div(x, C(a[0])));
+                var k0y = Let(Div(y, C(a[1])));
+                var k0z = Let(Div(z, C(a[2])));
+                var k1x = Let(Div(x, C(a[0] * a[0])));
+                var k1y = Let(Div(y, C(a[1] * a[1])));
+                var k1z = Let(Div(z, C(a[2] * a[2])));
+                var k0 = Let(Length(k0x, k0y, k0z));
+                var k1 = Let(Length(k1x, k1y, k1z));
+                return Let(Div(Mul(k0, Sub(k0, One)), k1));
+            }
+
+            case SdfNodeKind.Union:
+                return Let(Min(Emit(node.Inputs[0], x, y, z), Emit(node.Inputs[1], x, y, z)));
+            case SdfNodeKind.Intersection:
+                return Let(Max(Emit(node.Inputs[0], x, y, z), Emit(node.Inputs[1], x, y, z)));
+            case SdfNodeKind.Difference:
+                return Let(Max(Emit(node.Inputs[0], x, y, z), Expression.Negate(Emit(node.Inputs[1], x, y, z))));
+            case SdfNodeKind.SmoothUnion:
+            case SdfNodeKind.SmoothIntersection:
+            {
+                var k = a[0];
+                var da = Emit(node.Inputs[0], x, y, z);
+                var db = Emit(node.Inputs[1], x, y, z);
+                var h = Let(Div(Max(Sub(C(k), Abs(Sub(da, db))), Zero), C(k)));
+                var blend = Mul(Mul(h, h), C(k * (1.0 / 4.0)));
+                return node.Kind == SdfNodeKind.SmoothUnion
+                    ? Let(Sub(Min(da, db), blend))
+                    : Let(Add(Max(da, db), blend));
+            }
+            case SdfNodeKind.NaryUnion:
+            {
+                // Children are compiled separately and called through the hierarchy,
+                // which skips the ones too far away to matter
+                var kernels = Array.ConvertAll(node.Inputs, Nested);
+                return Let(Expression.Call(O(node.Bvh!), BvhEvaluateMethod, x, y, z, C(a[0]), O(kernels)));
+            }
+            case SdfNodeKind.SmoothDifference:
+            {
+                var k = a[0];
+                var da = Emit(node.Inputs[0], x, y, z);
+                var nb = Let(Expression.Negate(Emit(node.Inputs[1], x, y, z)));
+                var h = Let(Div(Max(Sub(C(k), Abs(Sub(nb, da))), Zero), C(k)));
+                return Let(Add(Max(nb, da), Mul(Mul(h, h), C(k * (1.0 / 4.0)))));
+            }
+
+            case SdfNodeKind.Translate:
+                return Emit(node.Inputs[0], Let(Sub(x, C(a[0]))), Let(Sub(y, C(a[1]))), Let(Sub(z, C(a[2]))));
+            case SdfNodeKind.Scale:
+            {
+                var d = Emit(node.Inputs[0], Let(Div(x, C(a[0]))), Let(Div(y, C(a[0]))), Let(Div(z, C(a[0]))));
+                return Let(Mul(d, C(a[0])));
+            }
+            case SdfNodeKind.Rotate:
+            {
+                var cos = Math.Cos(a[0]);
+                var sin = Math.Sin(a[0]);
+                var axis = Vector3Of(a, 1);
+                var dot = Let(Dot(x, y, z, axis));
+                // axis * dot + cross(axis, p) * sin + (p - axis * dot) * cos
+                var rx = Let(Add(Add(Mul(C(axis.X), dot), Mul(Sub(Mul(C(axis.Y), z), Mul(C(axis.Z), y)), C(sin))), Mul(Sub(x, Mul(C(axis.X), dot)), C(cos))));
+                var ry = Let(Add(Add(Mul(C(axis.Y), dot), Mul(Sub(Mul(C(axis.Z), x), Mul(C(axis.X), z)), C(sin))), Mul(Sub(y, Mul(C(axis.Y), dot)), C(cos))));
+                var rz = Let(Add(Add(Mul(C(axis.Z), dot), Mul(Sub(Mul(C(axis.X), y), Mul(C(axis.Y), x)), C(sin))), Mul(Sub(z, Mul(C(axis.Z), dot)), C(cos))));
+                return Emit(node.Inputs[0], rx, ry, rz);
+            }
+            case SdfNodeKind.Affine:
+            {
+                var rx = Let(Add(Add(Add(Mul(x, C(a[0])), Mul(y, C(a[1]))), Mul(z, C(a[2]))), C(a[9])));
+                var ry = Let(Add(Add(Add(Mul(x, C(a[3])), Mul(y, C(a[4]))), Mul(z, C(a[5]))), C(a[10])));
+                var rz = Let(Add(Add(Add(Mul(x, C(a[6])), Mul(y, C(a[7]))), Mul(z, C(a[8]))), C(a[11])));
+                var d = Emit(node.Inputs[0], rx, ry, rz);
+                return Branch(a[12] == 1) ? d : Let(Mul(d, C(a[12])));
+            }
+            case SdfNodeKind.Twist:
+            case SdfNodeKind.Bend:
+            {
+                var angle = Mul(C(a[0]), node.Kind == SdfNodeKind.Twist ? z : x);
+                var c = Let(Expression.Call(CosMethod, angle));
+                var s = Let(Expression.Call(SinMethod, angle));
+                var tx = Let(Sub(Mul(c, x), Mul(s, y)));
+                var ty = Let(Add(Mul(s, x), Mul(c, y)));
+                return Emit(node.Inputs[0], tx, ty, z);
+            }
+            case SdfNodeKind.Elongate:
+            {
+                var mx = Let(Max(Sub(Abs(x), C(a[0])), Zero));
+                var my = Let(Max(Sub(Abs(y), C(a[1])), Zero));
+                var mz = Let(Max(Sub(Abs(z), C(a[2])), Zero));
+                var d = Emit(node.Inputs[0], Let(Mul(Sign(x), mx)), Let(Mul(Sign(y), my)), Let(Mul(Sign(z), mz)));
+                return Let(Add(d, Length(mx, my, mz)));
+            }
+            case SdfNodeKind.Repeat:
+                if (Branch(node.Neighbors != null))
+                {
+                    // Neighbor cells are culled per point, so the child is compiled on its own
+                    var kernel = Nested(node.Inputs[0]);
+                    return Let(Expression.Call(O(node.Neighbors!), RepeatEvaluateMethod, x, y, z, O(kernel)));
+                }
+                return Emit(node.Inputs[0],
+                    Let(RepeatAxis(x, a[0], a[3])),
+                    Let(RepeatAxis(y, a[1], a[4])),
+                    Let(RepeatAxis(z, a[2], a[5])));
+
+            case SdfNodeKind.Dilate:
+                return Let(Sub(Emit(node.Inputs[0], x, y, z), C(a[0])));
+            case SdfNodeKind.Erode:
+                return Let(Add(Emit(node.Inputs[0], x, y, z), C(a[0])));
+            case SdfNodeKind.Shell:
+                return Let(Sub(Abs(Emit(node.Inputs[0], x, y, z)), C(a[0])));
+
+            default:
+                throw new NotSupportedException($"Cannot compile SDF node kind {node.Kind}");
+        }
+    }
+
+    private ParameterExpression Let(Expression value)
+    {
+        var variable = Expression.Variable(typeof(double));
+        _variables.Add(variable);
+        _body.Add(Expression.Assign(variable, value));
+        return variable;
+    }
+
+    private static Vector3 Vector3Of(double[] a, int i) => Evaluator.Vec(a, i);
+
+    /// <summary>
+    /// A constant taken from the node arguments; template kernels read it from
+    /// the constants array so another tree of the same shape can supply its own
+    /// </summary>
+    private Expression C(double value)
+    {
+        if (_constants == null)
+            return Expression.Constant(value);
+        _constantValues.Add(value);
+        return Expression.ArrayIndex(_constants, Expression.Constant(_constantValues.Count - 1));
+    }
+
+    /// <summary>
+    /// An object the kernel calls into, read from the objects array in template kernels
+    /// </summary>
+    private Expression O<T>(T value) where T : class
+    {
+        if (_objects == null)
+            return Expression.Constant(value, typeof(T));
+        _objectValues.Add(value);
+        return Expression.Convert(Expression.ArrayIndex(_objects, Expression.Constant(_objectValues.Count - 1)), typeof(T));
+    }
+
+    /// <summary>
+    /// A choice the emitted code depends on, recorded in the shape
+    /// </summary>
+    private bool Branch(bool condition)
+    {
+        _shape.Add(condition ? 1 : 0);
+        return condition;
+    }
+
+    /// <summary>
+    /// Kernel of a subtree called through a hierarchy rather than emitted inline
+    /// </summary>
+    private Func<double, double, double, double> Nested(SDF3 node) =>
+        _templates == null ? Compile(node) : Compile(node, _templates);
+    private static Expression Add(Expression a, Expression b) => Expression.Add(a, b);
+    private static Expression Sub(Expression a, Expression b) => Expression.Subtract(a, b);
+    private static Expression Mul(Expression a, Expression b) => Expression.Multiply(a, b);
+    private static Expression Div(Expression a, Expression b) => Expression.Divide(a, b);
+    private static Expression Sqrt(Expression a) => Expression.Call(SqrtMethod, a);
+    private static Expression Abs(Expression a) => Expression.Call(AbsMethod, a);
+    private static Expression Min(Expression a, Expression b) => Expression.Call(MinMethod, a, b);
+    private static Expression Max(Expression a, Expression b) => Expression.Call(MaxMethod, a, b);
+    private static Expression Clamp(Expression v, Expression lo, Expression hi) => Expression.Call(ClampMethod, v, lo, hi);
+    private static Expression Sign(Expression a) => Expression.Convert(Expression.Call(SignMethod, a), typeof(double));
+
+    private static Expression Length(Expression x, Expression y, Expression z) =>
+        Sqrt(Add(Add(Mul(x, x), Mul(y, y)), Mul(z, z)));
+
+    private Expression Dot(Expression x, Expression y, Expression z, Vector3 v) =>
+        Add(Add(Mul(x, C(v.X)), Mul(y, C(v.Y))), Mul(z, C(v.Z)));
+
+    private Expression BoxDistance(Expression qx, Expression qy, Expression qz)
+    {
+        var ox = Let(Max(qx, Zero));
+        var oy = Let(Max(qy, Zero));
+        var oz = Let(Max(qz, Zero));
+        var inside = Min(Max(qx, Max(qy, qz)), Zero);
+        return Add(Length(ox, oy, oz), inside);
+    }
+
+    private Expression RepeatAxis(Expression p, double spacing, double count) =>
+        Branch(spacing == 0) ? p : Sub(p, Mul(C(spacing), Expression.Call(RoundMethod, Clamp(Div(p, C(spacing)), C(-count), C(count)))));
+}
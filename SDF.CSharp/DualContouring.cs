@@ -0,0 +1,228 @@
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+
+namespace SDF;
+
+/// <summary>
+/// Dual contouring. Every lattice edge the surface crosses gets its crossing,
+/// interpolated linearly and moved onto the surface by a regula falsi step,
+/// and the field's normal there. Every cell the surface
+/// passes through gets one vertex, placed by minimizing the squared distances
+/// to the tangent planes at its crossings (<see cref="Qef"/>). Every crossed edge then
+/// joins the vertices of the four cells around it with a quad. Vertices land
+/// on sharp edges and corners rather than cutting across them. A cell still
+/// gets a single vertex where the surface crosses it in several sheets, so
+/// features thinner than the step and faces with four crossings can come out
+/// non-manifold.
+/// </summary>
+public static class DualContouring
+{
+    /// <summary>
+    /// Generate mesh triangles from a volume sampled from <paramref name="sdf"/>,
+    /// three vertices per triangle, wound counterclockwise seen from outside.
+    /// The normals at the crossings are taken from <paramref name="sdf"/>.
+    /// </summary>
+    public static List<Vector3> Generate<T>(T[,,] volume, Vector3 origin, Vector3 scale, SDF3 sdf)
+        where T : unmanaged, INumberBase<T>
+    {
+        var mesh = new BatchMesh();
+        Generate(volume, origin, scale, sdf, int.MaxValue, mesh);
+        var triangles = new List<Vector3>();
+        mesh.AppendTriangles(triangles);
+        return triangles;
+    }
+
+    /// <summary>
+    /// Mesh a volume into <paramref name="mesh"/>, each vertex once with the
+    /// cell it belongs to. The volume's cells overlap those of the next batch
+    /// by one layer, and the edges joined are those a batch of
+    /// <paramref name="owned"/> cells per axis owns: along the edge, the ones
+    /// starting in its first <paramref name="owned"/> samples; across it, the
+    /// ones with all four cells in the volume, skipping the first sample.
+    /// </summary>
+    internal static void Generate<T>(T[,,] volume, Vector3 origin, Vector3 scale, SDF3 sdf, int owned, BatchMesh mesh)
+        where T : unmanaged, INumberBase<T>
+    {
+        int sizeX = volume.GetLength(0);
+        int sizeY = volume.GetLength(1);
+        int sizeZ = volume.GetLength(2);
+        if (sizeX < 2 || sizeY < 2 || sizeZ < 2)
+            return;
+
+        // Samples are indexed as the volume is laid out, z fastest, and so are
+        // the edges starting at them and the cells whose lowest sample they are
+        int strideX = sizeY * sizeZ, strideY = sizeZ;
+        var values = new double[sizeX * strideX];
+        int s = 0;
+        for (int x = 0; x < sizeX; x++)
+            for (int y = 0; y < sizeY; y++)
+                for (int z = 0; z < sizeZ; z++)
+                    values[s++] = double.CreateTruncating(volume[x, y, z]);
+
+        var crossings = new int[values.Length * 3];
+        Array.Fill(crossings, -1);
+        var points = new List<Vector3>();
+        var edges = new List<int>();
+        for (int x = 0; x < sizeX; x++)
+        {
+            for (int y = 0; y < sizeY; y++)
+            {
+                for (int z = 0; z < sizeZ; z++)
+                {
+                    s = x * strideX + y * strideY + z;
+                    var v = values[s];
+                    if (x + 1 < sizeX && (v < 0) != (values[s + strideX] < 0))
+                        Cross(x + Crossing(v, values[s + strideX]), y, z, 3 * s);
+                    if (y + 1 < sizeY && (v < 0) != (values[s + strideY] < 0))
+                        Cross(x, y + Crossing(v, values[s + strideY]), z, 3 * s + 1);
+                    if (z + 1 < sizeZ && (v < 0) != (values[s + 1] < 0))
+                        Cross(x, y, z + Crossing(v, values[s + 1]), 3 * s + 2);
+                }
+            }
+        }
+        if (points.Count == 0)
+            return;
+
+        void Cross(double x, double y, double z, int edge)
+        {
+            crossings[edge] = points.Count;
+            points.Add(new Vector3(origin.X + x * scale.X, origin.Y + y * scale.Y, origin.Z + z * scale.Z));
+            edges.Add(edge);
+        }
+
+        // Near edges and corners the field is not linear between samples, and
+        // outside them its gradient points at the feature rather than along the
+        // face normal, so normals are taken at refined crossings
+        var at = points.ToArray();
+        var distances = sdf.Evaluate(at);
+        for (int i = 0; i < at.Length; i++)
+            at[i] = Refine(at[i], distances[i], edges[i], values, strideX, strideY, scale);
+        sdf.EvaluateWithGradient(at, out var normals);
+        for (int i = 0; i < at.Length; i++)
+        {
+            var n = normals[i];
+            normals[i] = double.IsFinite(n.X + n.Y + n.Z) ? n.Normalize() : Vector3.Zero;
+        }
+
+        // One vertex per cell with a crossing on any of its twelve edges
+        var cells = new int[values.Length];
+        for (int x = 0; x < sizeX - 1; x++)
+        {
+            for (int y = 0; y < sizeY - 1; y++)
+            {
+                for (int z = 0; z < sizeZ - 1; z++)
+                {
+                    s = x * strideX + y * strideY + z;
+                    var qef = new Qef();
+                    for (int j = 0; j < 4; j++)
+                    {
+                        int a = j & 1, b = j >> 1;
+                        Add(ref qef, crossings[3 * (s + a * strideY + b)]);
+                        Add(ref qef, crossings[3 * (s + a * strideX + b) + 1]);
+                        Add(ref qef, crossings[3 * (s + a * strideX + b * strideY) + 2]);
+                    }
+                    if (qef.Count == 0)
+                    {
+                        cells[s] = -1;
+                        continue;
+                    }
+
+                    // Solutions outside the cell come from nearly parallel planes; keeping
+                    // them in the cell keeps the quads from folding over
+                    var lo = new Vector3(origin.X + x * scale.X, origin.Y + y * scale.Y, origin.Z + z * scale.Z);
+                    var vertex = Vector3.Min(Vector3.Max(qef.Solve(), lo), lo + scale);
+                    cells[s] = mesh.Vertices.Count;
+                    mesh.Vertices.Add(vertex);
+                    mesh.Keys.Add(s);
+                }
+            }
+        }
+
+        void Add(ref Qef qef, int crossing)
+        {
+            if (crossing >= 0)
+                qef.Add(at[crossing], normals[crossing]);
+        }
+
+        // One quad per owned crossed edge, across the four cells around it
+        int alongX = Math.Min(owned, sizeX - 1), acrossX = Math.Min(owned, sizeX - 2);
+        int alongY = Math.Min(owned, sizeY - 1), acrossY = Math.Min(owned, sizeY - 2);
+        int alongZ = Math.Min(owned, sizeZ - 1), acrossZ = Math.Min(owned, sizeZ - 2);
+        foreach (var edge in edges)
+        {
+            s = edge / 3;
+            int x = s / strideX, y = s / strideY % sizeY, z = s % sizeZ;
+            int first, second;
+            switch (edge % 3)
+            {
+                case 0:
+                    if (x >= alongX || y < 1 || y > acrossY || z < 1 || z > acrossZ)
+                        continue;
+                    (first, second) = (strideY, 1);
+                    break;
+                case 1:
+                    if (y >= alongY || z < 1 || z > acrossZ || x < 1 || x > acrossX)
+                        continue;
+                    (first, second) = (1, strideX);
+                    break;
+                default:
+                    if (z >= alongZ || x < 1 || x > acrossX || y < 1 || y > acrossY)
+                        continue;
+                    (first, second) = (strideX, strideY);
+                    break;
+            }
+
+            // Around the edge's axis, counterclockwise from the cell below both
+            // neighbors; the surface faces away from the inside end of the edge
+            int c0 = cells[s - first - second], c1 = cells[s - second], c2 = cells[s], c3 = cells[s - first];
+            if (values[s] >= 0)
+                (c1, c3) = (c3, c1);
+            Quad(mesh, c0, c1, c2, c3);
+        }
+    }
+
+    /// <summary>
+    /// Two triangles of the quad c0 c1 c2 c3, split along its shorter diagonal
+    /// </summary>
+    private static void Quad(BatchMesh mesh, int c0, int c1, int c2, int c3)
+    {
+        var v = mesh.Vertices;
+        if ((v[c0] - v[c2]).LengthSquared() <= (v[c1] - v[c3]).LengthSquared())
+            mesh.Indices.AddRange(new[] { c0, c1, c2, c0, c2, c3 });
+        else
+            mesh.Indices.AddRange(new[] { c0, c1, c3, c1, c2, c3 });
+    }
+
+    /// <summary>
+    /// Move a crossing along its edge by a regula falsi step between the edge's
+    /// samples and the <paramref name="distance"/> evaluated at the crossing
+    /// </summary>
+    private static Vector3 Refine(Vector3 point, double distance, int edge, double[] values, int strideX, int strideY,
+        Vector3 scale)
+    {
+        int axis = edge % 3, s = edge / 3;
+        var v0 = values[s];
+        var v1 = values[s + (axis == 0 ? strideX : axis == 1 ? strideY : 1)];
+        var t = Crossing(v0, v1);
+        var refined = (distance < 0) == (v0 < 0)
+            ? t + (1 - t) * distance / (distance - v1)
+            : t * v0 / (v0 - distance);
+        if (double.IsNaN(refined))
+            return point;
+
+        var delta = (Math.Clamp(refined, 0.0, 1.0) - t) * (axis == 0 ? scale.X : axis == 1 ? scale.Y : scale.Z);
+        return axis switch
+        {
+            0 => new Vector3(point.X + delta, point.Y, point.Z),
+            1 => new Vector3(point.X, point.Y + delta, point.Z),
+            _ => new Vector3(point.X, point.Y, point.Z + delta),
+        };
+    }
+
+    /// <summary>
+    /// Fraction of the way from a sample of value <paramref name="v0"/> to its
+    /// neighbor of value <paramref name="v1"/> where the linear interpolant is zero
+    /// </summary>
+    private static double Crossing(double v0, double v1) => v0 / (v0 - v1);
+}
@@ -0,0 +1,77 @@
+using System;
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Pool of temporary float buffers used while evaluating an SDF tree.
+/// Buffers are handed out in stack order and kept between calls, so
+/// repeated evaluations of the same batch size allocate nothing.
+/// An instance must only be used by one thread at a time.
+/// </summary>
+public sealed class EvalScratch
+{
+    [ThreadStatic]
+    private static EvalScratch? _current;
+
+    private readonly List<float[]> _buffers = new();
+    private int _top;
+
+    /// <summary>
+    /// Scratch pool owned by the calling thread
+    /// </summary>
+    public static EvalScratch Current => _current ??= new EvalScratch();
+
+    /// <summary>
+    /// Total number of floats currently held by the pool
+    /// </summary>
+    public long Capacity
+    {
+        get
+        {
+            long total = 0;
+            foreach (var buffer in _buffers)
+                total += buffer.Length;
+            return total;
+        }
+    }
+
+    /// <summary>
+    /// Position to pass to <see cref="Release"/> to return every buffer rented after this point
+    /// </summary>
+    internal int Mark => _top;
+
+    /// <summary>
+    /// Rent a buffer of at least <paramref name="length"/> floats (contents are undefined)
+    /// </summary>
+    internal Span<float> Rent(int length)
+    {
+        if (_top == _buffers.Count)
+        {
+            _buffers.Add(new float[length]);
+        }
+        else if (_buffers[_top].Length < length)
+        {
+            _buffers[_top] = new float[length];
+        }
+        return _buffers[_top++].AsSpan(0, length);
+    }
+
+    /// <summary>
+    /// Return every buffer rented since <paramref name="mark"/> was taken
+    /// </summary>
+    internal void Release(int mark)
+    {
+        _top = mark;
+    }
+
+    /// <summary>
+    /// Drop all pooled buffers
+    /// </summary>
+    public void Clear()
+    {
+        if (_top != 0)
+            throw new InvalidOperationException("Cannot clear a scratch pool while buffers are rented");
+        _buffers.Clear();
+    }
+}
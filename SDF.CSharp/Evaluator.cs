@@ -0,0 +1,923 @@
+using System;
+using System.Buffers;
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Interprets an SDF3 expression graph over arrays of points
+/// </summary>
+internal static class Evaluator
+{
+    /// <summary>
+    /// Evaluate a node (and its subtree) at the given points
+    /// </summary>
+    public static double[] Evaluate(SDF3 node, Vector3[] points)
+    {
+        // A fused kernel hides its nodes, so profiled runs interpret the tree
+        if (node.Kernel is { } kernel && Profiler.Current == null)
+            return Run(kernel, points);
+
+        return Evaluate(node, points, SharedMemo<(SDF3, Vector3[]), double[]>.For(node));
+    }
+
+    private static double[] Run(Func<double, double, double, double> kernel, Vector3[] points)
+    {
+        var values = new double[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            values[i] = kernel(p.X, p.Y, p.Z);
+        }
+        return values;
+    }
+
+    /// <summary>
+    /// Shared subtrees are looked up by the point array they are evaluated at, so
+    /// a repeated subtree under the same transforms is computed once per call
+    /// </summary>
+    private static double[] Evaluate(SDF3 node, Vector3[] points, SharedMemo<(SDF3, Vector3[]), double[]>? memo)
+    {
+        var profiler = Profiler.Current;
+        profiler?.Enter(node, points.Length);
+        try
+        {
+            if (memo == null || !memo.IsShared(node))
+                return EvaluateTiered(node, points, memo);
+
+            // Callers combine results in place, so the memo keeps its own copy
+            if (!memo.Values.TryGetValue((node, points), out var cached))
+            {
+                cached = EvaluateTiered(node, points, memo);
+                memo.Values[(node, points)] = cached;
+            }
+            return (double[])cached.Clone();
+        }
+        finally
+        {
+            profiler?.Exit();
+        }
+    }
+
+    /// <summary>
+    /// Evaluate through the kernel or grid the node was promoted to (see
+    /// <see cref="TieredEvaluation"/>), counting its points toward promotion until then.
+    /// Profiled runs always interpret, so every node keeps its own timings.
+    /// </summary>
+    private static double[] EvaluateTiered(SDF3 node, Vector3[] points, SharedMemo<(SDF3, Vector3[]), double[]>? memo)
+    {
+        if (!TieredEvaluation.Enabled || !node.Promotable || Profiler.Current != null)
+            return EvaluateNode(node, points, memo);
+
+        var tier = node.Tier;
+        if (tier.Grid is { } grid)
+        {
+            var values = new double[points.Length];
+            List<int>? outside = null;
+            for (int i = 0; i < points.Length; i++)
+            {
+                var p = points[i];
+                if (!grid.TrySample(p.X, p.Y, p.Z, out values[i]))
+                    (outside ??= new List<int>()).Add(i);
+            }
+            if (outside != null)
+            {
+                // Points off the grid are evaluated exactly
+                var rest = new Vector3[outside.Count];
+                for (int i = 0; i < rest.Length; i++)
+                    rest[i] = points[outside[i]];
+                var exact = EvaluateNode(node, rest, memo);
+                for (int i = 0; i < rest.Length; i++)
+                    values[outside[i]] = exact[i];
+            }
+            return values;
+        }
+        if (tier.Kernel is { } kernel)
+            return Run(kernel, points);
+
+        tier.Count(node, points.Length);
+        return EvaluateNode(node, points, memo);
+    }
+
+    private static double[] EvaluateNode(SDF3 node, Vector3[] points, SharedMemo<(SDF3, Vector3[]), double[]>? memo)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Custom:
+                return node.Function!(points);
+
+            case SdfNodeKind.Sphere:
+                return Sphere(points, a[0], Vec(a, 1));
+            case SdfNodeKind.Box:
+                return Box(points, Vec(a, 0) / 2.0, Vec(a, 3));
+            case SdfNodeKind.Cylinder:
+                return Cylinder(points, a[0]);
+            case SdfNodeKind.CappedCylinder:
+                return CappedCylinder(points, Vec(a, 0), Vec(a, 3), a[6]);
+            case SdfNodeKind.Plane:
+                return Plane(points, Vec(a, 0), Vec(a, 3));
+            case SdfNodeKind.Torus:
+                return Torus(points, a[0], a[1]);
+            case SdfNodeKind.RoundedBox:
+                return RoundedBox(points, Vec(a, 0), a[3]);
+            case SdfNodeKind.Capsule:
+                return Capsule(points, Vec(a, 0), Vec(a, 3), a[6]);
+            case SdfNodeKind.Ellipsoid:
+                return Ellipsoid(points, Vec(a, 0));
+
+            case SdfNodeKind.Union:
+            case SdfNodeKind.Intersection:
+            case SdfNodeKind.Difference:
+            case SdfNodeKind.SmoothUnion:
+            case SdfNodeKind.SmoothIntersection:
+            case SdfNodeKind.SmoothDifference:
+            {
+                var da = Evaluate(node.Inputs[0], points, memo);
+                var db = Evaluate(node.Inputs[1], points, memo);
+                Combine(node.Kind, node.Kind >= SdfNodeKind.SmoothUnion ? a[0] : 0, da, db);
+                return da;
+            }
+            case SdfNodeKind.NaryUnion:
+                return node.Bvh!.Evaluate(node.Inputs, a[0], points);
+
+            case SdfNodeKind.Translate:
+                return Evaluate(node.Inputs[0], Translate(points, Vec(a, 0)), memo);
+            case SdfNodeKind.Scale:
+            {
+                var result = Evaluate(node.Inputs[0], Scale(points, a[0]), memo);
+                for (int i = 0; i < result.Length; i++)
+                {
+                    result[i] *= a[0];
+                }
+                return result;
+            }
+            case SdfNodeKind.Rotate:
+                return Evaluate(node.Inputs[0], Rotate(points, a[0], Vec(a, 1)), memo);
+            case SdfNodeKind.Affine:
+            {
+                var result = Evaluate(node.Inputs[0], Affine(points, a), memo);
+                if (a[12] != 1)
+                {
+                    for (int i = 0; i < result.Length; i++)
+                    {
+                        result[i] *= a[12];
+                    }
+                }
+                return result;
+            }
+            case SdfNodeKind.Twist:
+                return Evaluate(node.Inputs[0], Twist(points, a[0]), memo);
+            case SdfNodeKind.Bend:
+                return Evaluate(node.Inputs[0], Bend(points, a[0]), memo);
+            case SdfNodeKind.Elongate:
+            {
+                var size = Vec(a, 0);
+                var result = Evaluate(node.Inputs[0], Elongate(points, size), memo);
+                for (int i = 0; i < result.Length; i++)
+                {
+                    result[i] += ElongateOutside(points[i], size);
+                }
+                return result;
+            }
+            case SdfNodeKind.Repeat:
+                if (node.Neighbors is { } neighbors)
+                    return neighbors.Evaluate(node.Inputs[0], points);
+                return Evaluate(node.Inputs[0], Repeat(points, Vec(a, 0), Vec(a, 3)), memo);
+
+            case SdfNodeKind.Dilate:
+            case SdfNodeKind.Erode:
+            case SdfNodeKind.Shell:
+            {
+                var result = Evaluate(node.Inputs[0], points, memo);
+                Modify(node.Kind, a[0], result);
+                return result;
+            }
+
+            default:
+                throw new NotSupportedException($"Unknown SDF node kind {node.Kind}");
+        }
+    }
+
+    internal static Vector3 Vec(double[] a, int i) => new(a[i], a[i + 1], a[i + 2]);
+
+    /// <summary>
+    /// Evaluate a node (and its subtree) over structure-of-arrays float lanes,
+    /// writing distances to <paramref name="d"/>. Temporaries come from
+    /// <paramref name="scratch"/> and are returned before this call exits.
+    /// </summary>
+    public static void Evaluate(SDF3 node, ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        EvalScratch scratch)
+    {
+        var memo = SharedMemo<(SDF3, int), float[]>.For(node);
+        try
+        {
+            Evaluate(node, x, y, z, d, scratch, memo, 0);
+        }
+        finally
+        {
+            if (memo != null)
+            {
+                foreach (var values in memo.Values.Values)
+                    ArrayPool<float>.Shared.Return(values);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Shared subtrees are looked up by the id of the lanes they are evaluated at:
+    /// the caller's lanes are domain 0 and every transform output gets a new id.
+    /// Cached values live in pooled arrays, since scratch memory is released as
+    /// soon as the subtree that rented it returns.
+    /// </summary>
+    private static void Evaluate(SDF3 node, ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        EvalScratch scratch, SharedMemo<(SDF3, int), float[]>? memo, int domain)
+    {
+        var profiler = Profiler.Current;
+        profiler?.Enter(node, d.Length);
+        try
+        {
+            if (memo == null || !memo.IsShared(node))
+            {
+                EvaluateTiered(node, x, y, z, d, scratch, memo, domain);
+                return;
+            }
+
+            if (!memo.Values.TryGetValue((node, domain), out var cached))
+            {
+                EvaluateTiered(node, x, y, z, d, scratch, memo, domain);
+                cached = ArrayPool<float>.Shared.Rent(d.Length);
+                d.CopyTo(cached);
+                memo.Values[(node, domain)] = cached;
+                return;
+            }
+            cached.AsSpan(0, d.Length).CopyTo(d);
+        }
+        finally
+        {
+            profiler?.Exit();
+        }
+    }
+
+    /// <summary>
+    /// Float lanes only take baked grids: the SIMD walker already outruns a
+    /// double kernel called point by point
+    /// </summary>
+    private static void EvaluateTiered(SDF3 node, ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        EvalScratch scratch, SharedMemo<(SDF3, int), float[]>? memo, int domain)
+    {
+        if (!TieredEvaluation.Enabled || node.BakeStep == null || Profiler.Current != null)
+        {
+            EvaluateNode(node, x, y, z, d, scratch, memo, domain);
+            return;
+        }
+
+        var tier = node.Tier;
+        if (tier.Grid is not { } grid)
+        {
+            tier.Count(node, d.Length);
+            EvaluateNode(node, x, y, z, d, scratch, memo, domain);
+            return;
+        }
+
+        // Points off the grid are marked NaN, then gathered and evaluated exactly
+        int n = d.Length, outside = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (grid.TrySample(x[i], y[i], z[i], out var value) && !double.IsNaN(value))
+            {
+                d[i] = (float)value;
+            }
+            else
+            {
+                d[i] = float.NaN;
+                outside++;
+            }
+        }
+        if (outside == 0)
+            return;
+
+        var mark = scratch.Mark;
+        var rx = scratch.Rent(outside);
+        var ry = scratch.Rent(outside);
+        var rz = scratch.Rent(outside);
+        var rd = scratch.Rent(outside);
+        for (int i = 0, j = 0; i < n; i++)
+        {
+            if (float.IsNaN(d[i]))
+            {
+                rx[j] = x[i];
+                ry[j] = y[i];
+                rz[j++] = z[i];
+            }
+        }
+        EvaluateNode(node, rx, ry, rz, rd, scratch, memo, memo?.NewDomain() ?? 0);
+        for (int i = 0, j = 0; i < n; i++)
+        {
+            if (float.IsNaN(d[i]))
+            {
+                d[i] = rd[j++];
+            }
+        }
+        scratch.Release(mark);
+    }
+
+    private static void EvaluateNode(SDF3 node, ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        EvalScratch scratch, SharedMemo<(SDF3, int), float[]>? memo, int domain)
+    {
+        var a = node.Args;
+        int n = d.Length;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Custom:
+            {
+                var points = new Vector3[n];
+                for (int i = 0; i < n; i++)
+                {
+                    points[i] = new Vector3(x[i], y[i], z[i]);
+                }
+                var values = node.Function!(points);
+                for (int i = 0; i < n; i++)
+                {
+                    d[i] = (float)values[i];
+                }
+                return;
+            }
+
+            case SdfNodeKind.Sphere:
+                SimdKernels.Sphere(x, y, z, d, (float)a[0], (float)a[1], (float)a[2], (float)a[3]);
+                return;
+            case SdfNodeKind.Box:
+                SimdKernels.Box(x, y, z, d, (float)(a[0] / 2.0), (float)(a[1] / 2.0), (float)(a[2] / 2.0),
+                    (float)a[3], (float)a[4], (float)a[5]);
+                return;
+            case SdfNodeKind.Cylinder:
+            {
+                var radius = (float)a[0];
+                for (int i = 0; i < n; i++)
+                {
+                    d[i] = MathF.Sqrt(x[i] * x[i] + y[i] * y[i]) - radius;
+                }
+                return;
+            }
+            case SdfNodeKind.CappedCylinder:
+                SimdKernels.CappedCylinder(x, y, z, d, (float)a[0], (float)a[1], (float)a[2],
+                    (float)a[3], (float)a[4], (float)a[5], (float)a[6]);
+                return;
+            case SdfNodeKind.Plane:
+            {
+                float nx = (float)a[0], ny = (float)a[1], nz = (float)a[2];
+                float px = (float)a[3], py = (float)a[4], pz = (float)a[5];
+                for (int i = 0; i < n; i++)
+                {
+                    d[i] = (x[i] - px) * nx + (y[i] - py) * ny + (z[i] - pz) * nz;
+                }
+                return;
+            }
+            case SdfNodeKind.Torus:
+                SimdKernels.Torus(x, y, z, d, (float)a[0], (float)a[1]);
+                return;
+            case SdfNodeKind.RoundedBox:
+                SimdKernels.Box(x, y, z, d, (float)(a[0] / 2.0 - a[3]), (float)(a[1] / 2.0 - a[3]), (float)(a[2] / 2.0 - a[3]), 0, 0, 0);
+                SimdKernels.Modify(d, 1, 0, -(float)a[3]);
+                return;
+            case SdfNodeKind.Capsule:
+                SimdKernels.Capsule(x, y, z, d, (float)a[0], (float)a[1], (float)a[2],
+                    (float)a[3], (float)a[4], (float)a[5], (float)a[6]);
+                return;
+            case SdfNodeKind.Ellipsoid:
+            {
+                float sx = (float)a[0], sy = (float)a[1], sz = (float)a[2];
+                for (int i = 0; i < n; i++)
+                {
+                    float k0x = x[i] / sx, k0y = y[i] / sy, k0z = z[i] / sz;
+                    float k1x = k0x / sx, k1y = k0y / sy, k1z = k0z / sz;
+                    var k0 = MathF.Sqrt(k0x * k0x + k0y * k0y + k0z * k0z);
+                    var k1 = MathF.Sqrt(k1x * k1x + k1y * k1y + k1z * k1z);
+                    d[i] = k0 * (k0 - 1f) / k1;
+                }
+                return;
+            }
+
+            case SdfNodeKind.Union:
+            case SdfNodeKind.Intersection:
+            case SdfNodeKind.Difference:
+            case SdfNodeKind.SmoothUnion:
+            case SdfNodeKind.SmoothIntersection:
+            case SdfNodeKind.SmoothDifference:
+            {
+                var mark = scratch.Mark;
+                var db = scratch.Rent(n);
+                Evaluate(node.Inputs[0], x, y, z, d, scratch, memo, domain);
+                Evaluate(node.Inputs[1], x, y, z, db, scratch, memo, domain);
+                SimdKernels.Combine(node.Kind, node.Kind >= SdfNodeKind.SmoothUnion ? (float)a[0] : 0f, d, db);
+                scratch.Release(mark);
+                return;
+            }
+            case SdfNodeKind.NaryUnion:
+                node.Bvh!.Evaluate(node.Inputs, a[0], x, y, z, d, scratch);
+                return;
+
+            case SdfNodeKind.Translate:
+            case SdfNodeKind.Scale:
+            case SdfNodeKind.Rotate:
+            case SdfNodeKind.Affine:
+            {
+                Span<float> m = stackalloc float[9];
+                var t = Vector3.Zero;
+                var scale = 1.0;
+                switch (node.Kind)
+                {
+                    case SdfNodeKind.Translate:
+                        ScaleMatrix(1.0, m);
+                        t = -Vec(a, 0);
+                        break;
+                    case SdfNodeKind.Scale:
+                        ScaleMatrix(1.0 / a[0], m);
+                        scale = a[0];
+                        break;
+                    case SdfNodeKind.Affine:
+                        for (int i = 0; i < 9; i++)
+                        {
+                            m[i] = (float)a[i];
+                        }
+                        t = Vec(a, 9);
+                        scale = a[12];
+                        break;
+                    default:
+                        RotationMatrix(a[0], Vec(a, 1), m);
+                        break;
+                }
+                var mark = scratch.Mark;
+                var tx = scratch.Rent(n);
+                var ty = scratch.Rent(n);
+                var tz = scratch.Rent(n);
+                SimdKernels.Affine(x, y, z, tx, ty, tz, m, (float)t.X, (float)t.Y, (float)t.Z);
+                Evaluate(node.Inputs[0], tx, ty, tz, d, scratch, memo, memo?.NewDomain() ?? 0);
+                scratch.Release(mark);
+                if (scale != 1)
+                {
+                    SimdKernels.Modify(d, (float)scale, 0, 0);
+                }
+                return;
+            }
+            case SdfNodeKind.Twist:
+            case SdfNodeKind.Bend:
+            {
+                var k = (float)a[0];
+                var twist = node.Kind == SdfNodeKind.Twist;
+                var mark = scratch.Mark;
+                var tx = scratch.Rent(n);
+                var ty = scratch.Rent(n);
+                for (int i = 0; i < n; i++)
+                {
+                    var (s, c) = MathF.SinCos(k * (twist ? z[i] : x[i]));
+                    tx[i] = c * x[i] - s * y[i];
+                    ty[i] = s * x[i] + c * y[i];
+                }
+                Evaluate(node.Inputs[0], tx, ty, z, d, scratch, memo, memo?.NewDomain() ?? 0);
+                scratch.Release(mark);
+                return;
+            }
+            case SdfNodeKind.Elongate:
+            {
+                float sx = (float)a[0], sy = (float)a[1], sz = (float)a[2];
+                var mark = scratch.Mark;
+                var tx = scratch.Rent(n);
+                var ty = scratch.Rent(n);
+                var tz = scratch.Rent(n);
+                for (int i = 0; i < n; i++)
+                {
+                    tx[i] = MathF.Sign(x[i]) * MathF.Max(MathF.Abs(x[i]) - sx, 0);
+                    ty[i] = MathF.Sign(y[i]) * MathF.Max(MathF.Abs(y[i]) - sy, 0);
+                    tz[i] = MathF.Sign(z[i]) * MathF.Max(MathF.Abs(z[i]) - sz, 0);
+                }
+                Evaluate(node.Inputs[0], tx, ty, tz, d, scratch, memo, memo?.NewDomain() ?? 0);
+                for (int i = 0; i < n; i++)
+                {
+                    float mx = MathF.Abs(tx[i]), my = MathF.Abs(ty[i]), mz = MathF.Abs(tz[i]);
+                    d[i] += MathF.Sqrt(mx * mx + my * my + mz * mz);
+                }
+                scratch.Release(mark);
+                return;
+            }
+            case SdfNodeKind.Repeat:
+            {
+                if (node.Neighbors is { } neighbors)
+                {
+                    neighbors.Evaluate(node.Inputs[0], x, y, z, d, scratch);
+                    return;
+                }
+                var mark = scratch.Mark;
+                var tx = scratch.Rent(n);
+                var ty = scratch.Rent(n);
+                var tz = scratch.Rent(n);
+                RepeatAxis(x, tx, a[0], a[3]);
+                RepeatAxis(y, ty, a[1], a[4]);
+                RepeatAxis(z, tz, a[2], a[5]);
+                Evaluate(node.Inputs[0], tx, ty, tz, d, scratch, memo, memo?.NewDomain() ?? 0);
+                scratch.Release(mark);
+                return;
+            }
+
+            case SdfNodeKind.Dilate:
+                Evaluate(node.Inputs[0], x, y, z, d, scratch, memo, domain);
+                SimdKernels.Modify(d, 1, 0, -(float)a[0]);
+                return;
+            case SdfNodeKind.Erode:
+                Evaluate(node.Inputs[0], x, y, z, d, scratch, memo, domain);
+                SimdKernels.Modify(d, 1, 0, (float)a[0]);
+                return;
+            case SdfNodeKind.Shell:
+                Evaluate(node.Inputs[0], x, y, z, d, scratch, memo, domain);
+                SimdKernels.Modify(d, 0, 1, -(float)a[0]);
+                return;
+
+            default:
+                throw new NotSupportedException($"Unknown SDF node kind {node.Kind}");
+        }
+    }
+
+    private static void ScaleMatrix(double s, Span<float> m)
+    {
+        m.Clear();
+        m[0] = m[4] = m[8] = (float)s;
+    }
+
+    /// <summary>
+    /// Row-major matrix of the point map used by Rotate:
+    /// cos * p + sin * (axis x p) + (1 - cos) * axis * (axis . p)
+    /// </summary>
+    internal static void RotationMatrix(double angle, Vector3 axis, Span<float> m)
+    {
+        Span<double> md = stackalloc double[9];
+        RotationMatrix(angle, axis, md);
+        for (int i = 0; i < 9; i++)
+        {
+            m[i] = (float)md[i];
+        }
+    }
+
+    internal static void RotationMatrix(double angle, Vector3 axis, Span<double> m)
+    {
+        var c = Math.Cos(angle);
+        var s = Math.Sin(angle);
+        var t = 1 - c;
+        double x = axis.X, y = axis.Y, z = axis.Z;
+        m[0] = c + t * x * x;
+        m[1] = t * x * y - s * z;
+        m[2] = t * x * z + s * y;
+        m[3] = t * x * y + s * z;
+        m[4] = c + t * y * y;
+        m[5] = t * y * z - s * x;
+        m[6] = t * x * z - s * y;
+        m[7] = t * y * z + s * x;
+        m[8] = c + t * z * z;
+    }
+
+    private static void RepeatAxis(ReadOnlySpan<float> p, Span<float> q, double spacing, double count)
+    {
+        var s = (float)spacing;
+        var c = (float)count;
+        if (s == 0)
+        {
+            p.CopyTo(q);
+            return;
+        }
+        for (int i = 0; i < p.Length; i++)
+        {
+            q[i] = p[i] - s * MathF.Round(Math.Clamp(p[i] / s, -c, c));
+        }
+    }
+
+    // Primitives
+
+    private static double[] Sphere(Vector3[] points, double radius, Vector3 c)
+    {
+        var result = new double[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var diff = points[i] - c;
+            result[i] = diff.Length() - radius;
+        }
+        return result;
+    }
+
+    private static double[] Box(Vector3[] points, Vector3 halfSize, Vector3 c)
+    {
+        var result = new double[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i] - c;
+            var q = new Vector3(
+                Math.Abs(p.X) - halfSize.X,
+                Math.Abs(p.Y) - halfSize.Y,
+                Math.Abs(p.Z) - halfSize.Z
+            );
+            var outside = Vector3.Max(q, Vector3.Zero).Length();
+            var inside = Math.Min(Math.Max(q.X, Math.Max(q.Y, q.Z)), 0.0);
+            result[i] = outside + inside;
+        }
+        return result;
+    }
+
+    private static double[] Cylinder(Vector3[] points, double radius)
+    {
+        var result = new double[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            var d = Math.Sqrt(p.X * p.X + p.Y * p.Y);
+            result[i] = d - radius;
+        }
+        return result;
+    }
+
+    private static double[] CappedCylinder(Vector3[] points, Vector3 a, Vector3 b, double radius)
+    {
+        var result = new double[points.Length];
+        var ba = b - a;
+        var baba = Vector3.Dot(ba, ba);
+
+        for (int i = 0; i < points.Length; i++)
+        {
+            var pa = points[i] - a;
+            var paba = Vector3.Dot(pa, ba);
+            var x = (pa * baba - ba * paba).Length() - radius * baba;
+            var y = Math.Abs(paba - baba * 0.5) - baba * 0.5;
+            var x2 = x * x;
+            var y2 = y * y * baba;
+            var d = (Math.Max(x, y) < 0) ? -Math.Min(x2, y2) : ((x > 0) ? x2 : 0) + ((y > 0) ? y2 : 0);
+            result[i] = Math.Sign(d) * Math.Sqrt(Math.Abs(d)) / baba;
+        }
+        return result;
+    }
+
+    private static double[] Plane(Vector3[] points, Vector3 n, Vector3 pt)
+    {
+        var result = new double[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            result[i] = Vector3.Dot(points[i] - pt, n);
+        }
+        return result;
+    }
+
+    private static double[] Torus(Vector3[] points, double r1, double r2)
+    {
+        var result = new double[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            var qx = Math.Sqrt(p.X * p.X + p.Y * p.Y) - r1;
+            var qy = p.Z;
+            result[i] = Math.Sqrt(qx * qx + qy * qy) - r2;
+        }
+        return result;
+    }
+
+    private static double[] RoundedBox(Vector3[] points, Vector3 size, double radius)
+    {
+        var halfSize = size / 2.0 - new Vector3(radius, radius, radius);
+        var result = new double[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            var q = new Vector3(
+                Math.Abs(p.X) - halfSize.X,
+                Math.Abs(p.Y) - halfSize.Y,
+                Math.Abs(p.Z) - halfSize.Z
+            );
+            var outside = Vector3.Max(q, Vector3.Zero).Length();
+            var inside = Math.Min(Math.Max(q.X, Math.Max(q.Y, q.Z)), 0.0);
+            result[i] = outside + inside - radius;
+        }
+        return result;
+    }
+
+    private static double[] Capsule(Vector3[] points, Vector3 a, Vector3 b, double radius)
+    {
+        var result = new double[points.Length];
+        var ba = b - a;
+        var baba = Vector3.Dot(ba, ba);
+
+        for (int i = 0; i < points.Length; i++)
+        {
+            var pa = points[i] - a;
+            var h = Math.Clamp(Vector3.Dot(pa, ba) / baba, 0.0, 1.0);
+            result[i] = (pa - ba * h).Length() - radius;
+        }
+        return result;
+    }
+
+    private static double[] Ellipsoid(Vector3[] points, Vector3 size)
+    {
+        var result = new double[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            var k0 = new Vector3(p.X / size.X, p.Y / size.Y, p.Z / size.Z).Length();
+            var k1 = new Vector3(p.X / (size.X * size.X), p.Y / (size.Y * size.Y), p.Z / (size.Z * size.Z)).Length();
+            result[i] = k0 * (k0 - 1.0) / k1;
+        }
+        return result;
+    }
+
+    // Booleans
+
+    /// <summary>
+    /// Combine two distance arrays in place (result is written to <paramref name="da"/>)
+    /// </summary>
+    private static void Combine(SdfNodeKind kind, double k, double[] da, double[] db)
+    {
+        switch (kind)
+        {
+            case SdfNodeKind.Union:
+                for (int i = 0; i < da.Length; i++)
+                    da[i] = Math.Min(da[i], db[i]);
+                break;
+            case SdfNodeKind.Intersection:
+                for (int i = 0; i < da.Length; i++)
+                    da[i] = Math.Max(da[i], db[i]);
+                break;
+            case SdfNodeKind.Difference:
+                for (int i = 0; i < da.Length; i++)
+                    da[i] = Math.Max(da[i], -db[i]);
+                break;
+            case SdfNodeKind.SmoothUnion:
+                for (int i = 0; i < da.Length; i++)
+                {
+                    var h = Math.Max(k - Math.Abs(da[i] - db[i]), 0.0) / k;
+                    da[i] = Math.Min(da[i], db[i]) - h * h * k * (1.0 / 4.0);
+                }
+                break;
+            case SdfNodeKind.SmoothIntersection:
+                for (int i = 0; i < da.Length; i++)
+                {
+                    var h = Math.Max(k - Math.Abs(da[i] - db[i]), 0.0) / k;
+                    da[i] = Math.Max(da[i], db[i]) + h * h * k * (1.0 / 4.0);
+                }
+                break;
+            case SdfNodeKind.SmoothDifference:
+                for (int i = 0; i < da.Length; i++)
+                {
+                    var h = Math.Max(k - Math.Abs(-db[i] - da[i]), 0.0) / k;
+                    da[i] = Math.Max(-db[i], da[i]) + h * h * k * (1.0 / 4.0);
+                }
+                break;
+        }
+    }
+
+    // Domain transforms
+
+    private static Vector3[] Translate(Vector3[] points, Vector3 offset)
+    {
+        var translated = new Vector3[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            translated[i] = points[i] - offset;
+        }
+        return translated;
+    }
+
+    private static Vector3[] Scale(Vector3[] points, double factor)
+    {
+        var scaled = new Vector3[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            scaled[i] = points[i] / factor;
+        }
+        return scaled;
+    }
+
+    private static Vector3[] Rotate(Vector3[] points, double angle, Vector3 axis)
+    {
+        var cos = Math.Cos(angle);
+        var sin = Math.Sin(angle);
+        var rotated = new Vector3[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            var dot = Vector3.Dot(p, axis);
+            var cross = Vector3.Cross(axis, p);
+            rotated[i] = axis * dot + cross * sin + (p - axis * dot) * cos;
+        }
+        return rotated;
+    }
+
+    /// <summary>
+    /// Map every point through the 3x4 matrix in a[0..11]
+    /// </summary>
+    private static Vector3[] Affine(Vector3[] points, double[] a)
+    {
+        var mapped = new Vector3[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            mapped[i] = new Vector3(
+                a[0] * p.X + a[1] * p.Y + a[2] * p.Z + a[9],
+                a[3] * p.X + a[4] * p.Y + a[5] * p.Z + a[10],
+                a[6] * p.X + a[7] * p.Y + a[8] * p.Z + a[11]);
+        }
+        return mapped;
+    }
+
+    private static Vector3[] Twist(Vector3[] points, double k)
+    {
+        var twisted = new Vector3[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            var c = Math.Cos(k * p.Z);
+            var s = Math.Sin(k * p.Z);
+            twisted[i] = new Vector3(c * p.X - s * p.Y, s * p.X + c * p.Y, p.Z);
+        }
+        return twisted;
+    }
+
+    private static Vector3[] Bend(Vector3[] points, double k)
+    {
+        var bent = new Vector3[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            var c = Math.Cos(k * p.X);
+            var s = Math.Sin(k * p.X);
+            bent[i] = new Vector3(c * p.X - s * p.Y, s * p.X + c * p.Y, p.Z);
+        }
+        return bent;
+    }
+
+    private static Vector3[] Elongate(Vector3[] points, Vector3 size)
+    {
+        var elongated = new Vector3[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            var q = new Vector3(
+                Math.Abs(p.X) - size.X,
+                Math.Abs(p.Y) - size.Y,
+                Math.Abs(p.Z) - size.Z
+            );
+            elongated[i] = new Vector3(
+                Math.Sign(p.X) * Math.Max(q.X, 0),
+                Math.Sign(p.Y) * Math.Max(q.Y, 0),
+                Math.Sign(p.Z) * Math.Max(q.Z, 0)
+            );
+        }
+        return elongated;
+    }
+
+    private static double ElongateOutside(Vector3 p, Vector3 size)
+    {
+        var q = new Vector3(
+            Math.Abs(p.X) - size.X,
+            Math.Abs(p.Y) - size.Y,
+            Math.Abs(p.Z) - size.Z
+        );
+        return new Vector3(
+            Math.Max(q.X, 0),
+            Math.Max(q.Y, 0),
+            Math.Max(q.Z, 0)
+        ).Length();
+    }
+
+    private static Vector3[] Repeat(Vector3[] points, Vector3 spacing, Vector3 count)
+    {
+        var repeated = new Vector3[points.Length];
+        for (int i = 0; i < points.Length; i++)
+        {
+            var p = points[i];
+            repeated[i] = new Vector3(
+                RepeatAxis(p.X, spacing.X, count.X),
+                RepeatAxis(p.Y, spacing.Y, count.Y),
+                RepeatAxis(p.Z, spacing.Z, count.Z)
+            );
+        }
+        return repeated;
+    }
+
+    private static double RepeatAxis(double p, double spacing, double count) =>
+        spacing == 0 ? p : p - spacing * Math.Round(Math.Clamp(p / spacing, -count, count));
+
+    // Distance modifiers
+
+    private static void Modify(SdfNodeKind kind, double r, double[] result)
+    {
+        switch (kind)
+        {
+            case SdfNodeKind.Dilate:
+                for (int i = 0; i < result.Length; i++)
+                    result[i] -= r;
+                break;
+            case SdfNodeKind.Erode:
+                for (int i = 0; i < result.Length; i++)
+                    result[i] += r;
+                break;
+            case SdfNodeKind.Shell:
+                for (int i = 0; i < result.Length; i++)
+                    result[i] = Math.Abs(result[i]) - r;
+                break;
+        }
+    }
+}
@@ -0,0 +1,483 @@
+using System;
+
+namespace SDF;
+
+/// <summary>
+/// Evaluates an SDF3 expression graph on dual numbers, giving the distance and
+/// its gradient at many points in one pass. Formulas follow <see cref="Compiler"/>
+/// node for node, so values match the other evaluators.
+/// </summary>
+internal static class GradientEvaluator
+{
+    /// <summary>
+    /// Distance and gradient at every point
+    /// </summary>
+    public static Dual[] Evaluate(SDF3 node, Vector3[] points)
+    {
+        int n = points.Length;
+        var x = new Dual[n];
+        var y = new Dual[n];
+        var z = new Dual[n];
+        for (int i = 0; i < n; i++)
+        {
+            x[i] = new Dual(points[i].X, Vector3.UnitX);
+            y[i] = new Dual(points[i].Y, Vector3.UnitY);
+            z[i] = new Dual(points[i].Z, Vector3.UnitZ);
+        }
+        return Evaluate(node, x, y, z);
+    }
+
+    /// <summary>
+    /// Evaluate a node over packets of dual coordinates, one node at a time like
+    /// <see cref="Evaluator"/>
+    /// </summary>
+    /// <remarks>
+    /// Each loop lives in its own small method, as in <see cref="SimdKernels"/>;
+    /// a single large method exhausts the JIT's inlining budget and leaves the
+    /// dual arithmetic as calls.
+    /// </remarks>
+    public static Dual[] Evaluate(SDF3 node, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Custom:
+                return Custom(node, x, y, z);
+            case SdfNodeKind.Sphere:
+                return Sphere(a, x, y, z);
+            case SdfNodeKind.Box:
+                return Box(a, x, y, z);
+            case SdfNodeKind.Cylinder:
+                return Cylinder(a, x, y);
+            case SdfNodeKind.CappedCylinder:
+                return CappedCylinder(a, x, y, z);
+            case SdfNodeKind.Plane:
+                return Plane(a, x, y, z);
+            case SdfNodeKind.Torus:
+                return Torus(a, x, y, z);
+            case SdfNodeKind.RoundedBox:
+                return RoundedBox(a, x, y, z);
+            case SdfNodeKind.Capsule:
+                return Capsule(a, x, y, z);
+            case SdfNodeKind.Ellipsoid:
+                return Ellipsoid(a, x, y, z);
+
+            case SdfNodeKind.Union:
+            case SdfNodeKind.Intersection:
+            case SdfNodeKind.Difference:
+            case SdfNodeKind.SmoothUnion:
+            case SdfNodeKind.SmoothIntersection:
+            case SdfNodeKind.SmoothDifference:
+            {
+                var da = Evaluate(node.Inputs[0], x, y, z);
+                var db = Evaluate(node.Inputs[1], x, y, z);
+                Combine(node.Kind, node.Kind >= SdfNodeKind.SmoothUnion ? a[0] : 0, da, db);
+                return da;
+            }
+            case SdfNodeKind.NaryUnion:
+                return NaryUnion(node, x, y, z);
+
+            case SdfNodeKind.Translate:
+            case SdfNodeKind.Scale:
+            case SdfNodeKind.Rotate:
+            case SdfNodeKind.Affine:
+                return Linear(node, x, y, z);
+            case SdfNodeKind.Twist:
+            case SdfNodeKind.Bend:
+                return Twist(node, x, y, z);
+            case SdfNodeKind.Elongate:
+                return Elongate(node, x, y, z);
+            case SdfNodeKind.Repeat:
+                return Repeat(node, x, y, z);
+
+            case SdfNodeKind.Dilate:
+            case SdfNodeKind.Erode:
+            case SdfNodeKind.Shell:
+            {
+                var result = Evaluate(node.Inputs[0], x, y, z);
+                Modify(node.Kind, a[0], result);
+                return result;
+            }
+
+            default:
+                throw new NotSupportedException($"Unknown SDF node kind {node.Kind}");
+        }
+    }
+
+    private static Dual[] Sphere(double[] a, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+            d[i] = Dual.Length(x[i] - a[1], y[i] - a[2], z[i] - a[3]) - a[0];
+        return d;
+    }
+
+    private static Dual[] Box(double[] a, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+            d[i] = BoxDistance(Dual.Abs(x[i] - a[3]) - a[0] / 2.0, Dual.Abs(y[i] - a[4]) - a[1] / 2.0, Dual.Abs(z[i] - a[5]) - a[2] / 2.0);
+        return d;
+    }
+
+    private static Dual[] Cylinder(double[] a, Dual[] x, Dual[] y)
+    {
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+            d[i] = Dual.Sqrt(x[i] * x[i] + y[i] * y[i]) - a[0];
+        return d;
+    }
+
+    private static Dual[] CappedCylinder(double[] a, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var pa = Evaluator.Vec(a, 0);
+        var ba = Evaluator.Vec(a, 3) - pa;
+        var baba = Vector3.Dot(ba, ba);
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+        {
+            Dual pax = x[i] - pa.X, pay = y[i] - pa.Y, paz = z[i] - pa.Z;
+            var paba = pax * ba.X + pay * ba.Y + paz * ba.Z;
+            var qx = Dual.Length(pax * baba - paba * ba.X, pay * baba - paba * ba.Y, paz * baba - paba * ba.Z) - a[6] * baba;
+            var qy = Dual.Abs(paba - baba * 0.5) - baba * 0.5;
+            var x2 = qx * qx;
+            var y2 = qy * qy * baba;
+            var s = Dual.Max(qx, qy).Value < 0
+                ? -Dual.Min(x2, y2)
+                : (qx.Value > 0 ? x2 : new Dual(0)) + (qy.Value > 0 ? y2 : new Dual(0));
+            d[i] = Dual.Sqrt(Dual.Abs(s)) * (Math.Sign(s.Value) / baba);
+        }
+        return d;
+    }
+
+    private static Dual[] Plane(double[] a, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+            d[i] = (x[i] - a[3]) * a[0] + (y[i] - a[4]) * a[1] + (z[i] - a[5]) * a[2];
+        return d;
+    }
+
+    private static Dual[] Torus(double[] a, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+        {
+            var qx = Dual.Sqrt(x[i] * x[i] + y[i] * y[i]) - a[0];
+            d[i] = Dual.Sqrt(qx * qx + z[i] * z[i]) - a[1];
+        }
+        return d;
+    }
+
+    private static Dual[] RoundedBox(double[] a, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var radius = a[3];
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+        {
+            d[i] = BoxDistance(Dual.Abs(x[i]) - (a[0] / 2.0 - radius), Dual.Abs(y[i]) - (a[1] / 2.0 - radius),
+                Dual.Abs(z[i]) - (a[2] / 2.0 - radius)) - radius;
+        }
+        return d;
+    }
+
+    private static Dual[] Capsule(double[] a, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var pa = Evaluator.Vec(a, 0);
+        var ba = Evaluator.Vec(a, 3) - pa;
+        var baba = Vector3.Dot(ba, ba);
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+        {
+            Dual pax = x[i] - pa.X, pay = y[i] - pa.Y, paz = z[i] - pa.Z;
+            var h = Dual.Clamp((pax * ba.X + pay * ba.Y + paz * ba.Z) / baba, 0, 1);
+            d[i] = Dual.Length(pax - h * ba.X, pay - h * ba.Y, paz - h * ba.Z) - a[6];
+        }
+        return d;
+    }
+
+    private static Dual[] Ellipsoid(double[] a, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var d = new Dual[x.Length];
+        for (int i = 0; i < d.Length; i++)
+        {
+            var k0 = Dual.Length(x[i] / a[0], y[i] / a[1], z[i] / a[2]);
+            var k1 = Dual.Length(x[i] / (a[0] * a[0]), y[i] / (a[1] * a[1]), z[i] / (a[2] * a[2]));
+            d[i] = k0 * (k0 - 1) / k1;
+        }
+        return d;
+    }
+
+    private static Dual BoxDistance(Dual qx, Dual qy, Dual qz)
+    {
+        var outside = Dual.Length(Dual.Max(qx, 0), Dual.Max(qy, 0), Dual.Max(qz, 0));
+        var inside = Dual.Min(Dual.Max(qx, Dual.Max(qy, qz)), 0);
+        return outside + inside;
+    }
+
+    /// <summary>
+    /// Combine two packets in place into <paramref name="a"/>
+    /// </summary>
+    private static void Combine(SdfNodeKind kind, double k, Dual[] a, Dual[] b)
+    {
+        switch (kind)
+        {
+            case SdfNodeKind.Union:
+                for (int i = 0; i < a.Length; i++)
+                    a[i] = Dual.Min(a[i], b[i]);
+                break;
+            case SdfNodeKind.Intersection:
+                for (int i = 0; i < a.Length; i++)
+                    a[i] = Dual.Max(a[i], b[i]);
+                break;
+            case SdfNodeKind.Difference:
+                for (int i = 0; i < a.Length; i++)
+                    a[i] = Dual.Max(a[i], -b[i]);
+                break;
+            case SdfNodeKind.SmoothUnion:
+                for (int i = 0; i < a.Length; i++)
+                    a[i] = Dual.Min(a[i], b[i]) - Blend(a[i], b[i], k);
+                break;
+            case SdfNodeKind.SmoothIntersection:
+                for (int i = 0; i < a.Length; i++)
+                    a[i] = Dual.Max(a[i], b[i]) + Blend(a[i], b[i], k);
+                break;
+            default:
+                for (int i = 0; i < a.Length; i++)
+                    a[i] = Dual.Max(-b[i], a[i]) + Blend(-b[i], a[i], k);
+                break;
+        }
+    }
+
+    private static Dual Blend(Dual a, Dual b, double k)
+    {
+        var h = Dual.Max(k - Dual.Abs(a - b), 0) / k;
+        return h * h * (k * (1.0 / 4.0));
+    }
+
+    /// <summary>
+    /// Same blend of the two closest children as <see cref="UnionBvh"/>
+    /// </summary>
+    private static Dual[] NaryUnion(SDF3 node, Dual[] x, Dual[] y, Dual[] z)
+    {
+        int n = x.Length;
+        var best = new Dual[n];
+        var second = new Dual[n];
+        Array.Fill(best, new Dual(double.PositiveInfinity));
+        Array.Fill(second, new Dual(double.PositiveInfinity));
+        foreach (var child in node.Inputs)
+        {
+            var d = Evaluate(child, x, y, z);
+            for (int i = 0; i < n; i++)
+            {
+                if (d[i].Value < best[i].Value)
+                {
+                    second[i] = best[i];
+                    best[i] = d[i];
+                }
+                else if (d[i].Value < second[i].Value)
+                {
+                    second[i] = d[i];
+                }
+            }
+        }
+        var k = node.Args[0];
+        if (k > 0)
+        {
+            for (int i = 0; i < n; i++)
+                best[i] -= Blend(best[i], second[i], k);
+        }
+        return best;
+    }
+
+    private static Dual[] Linear(SDF3 node, Dual[] x, Dual[] y, Dual[] z)
+    {
+        int n = x.Length;
+        Span<double> m = stackalloc double[12];
+        var scale = Linear(node, m);
+        var tx = new Dual[n];
+        var ty = new Dual[n];
+        var tz = new Dual[n];
+        for (int i = 0; i < n; i++)
+        {
+            tx[i] = x[i] * m[0] + y[i] * m[1] + z[i] * m[2] + m[9];
+            ty[i] = x[i] * m[3] + y[i] * m[4] + z[i] * m[5] + m[10];
+            tz[i] = x[i] * m[6] + y[i] * m[7] + z[i] * m[8] + m[11];
+        }
+        var d = Evaluate(node.Inputs[0], tx, ty, tz);
+        if (scale != 1)
+        {
+            for (int i = 0; i < n; i++)
+                d[i] *= scale;
+        }
+        return d;
+    }
+
+    private static Dual[] Twist(SDF3 node, Dual[] x, Dual[] y, Dual[] z)
+    {
+        int n = x.Length;
+        var k = node.Args[0];
+        var axis = node.Kind == SdfNodeKind.Twist ? z : x;
+        var tx = new Dual[n];
+        var ty = new Dual[n];
+        for (int i = 0; i < n; i++)
+        {
+            var angle = axis[i] * k;
+            var c = Dual.Cos(angle);
+            var s = Dual.Sin(angle);
+            tx[i] = c * x[i] - s * y[i];
+            ty[i] = s * x[i] + c * y[i];
+        }
+        return Evaluate(node.Inputs[0], tx, ty, z);
+    }
+
+    /// <summary>
+    /// sign(p) * max(|p| - s, 0) is p - clamp(p, -s, s)
+    /// </summary>
+    private static Dual[] Elongate(SDF3 node, Dual[] x, Dual[] y, Dual[] z)
+    {
+        int n = x.Length;
+        var a = node.Args;
+        var tx = new Dual[n];
+        var ty = new Dual[n];
+        var tz = new Dual[n];
+        for (int i = 0; i < n; i++)
+        {
+            tx[i] = x[i] - Dual.Clamp(x[i], -a[0], a[0]);
+            ty[i] = y[i] - Dual.Clamp(y[i], -a[1], a[1]);
+            tz[i] = z[i] - Dual.Clamp(z[i], -a[2], a[2]);
+        }
+        var d = Evaluate(node.Inputs[0], tx, ty, tz);
+        for (int i = 0; i < n; i++)
+            d[i] += Dual.Length(tx[i], ty[i], tz[i]);
+        return d;
+    }
+
+    private static void Modify(SdfNodeKind kind, double amount, Dual[] d)
+    {
+        for (int i = 0; i < d.Length; i++)
+        {
+            d[i] = kind switch
+            {
+                SdfNodeKind.Dilate => d[i] - amount,
+                SdfNodeKind.Erode => d[i] + amount,
+                _ => Dual.Abs(d[i]) - amount,
+            };
+        }
+    }
+
+    /// <summary>
+    /// Row-major 3x4 map [M | t] of a translate, rotate, scale or affine node,
+    /// returning the factor applied to the child's distance
+    /// </summary>
+    private static double Linear(SDF3 node, Span<double> m)
+    {
+        var a = node.Args;
+        m.Clear();
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Translate:
+                m[0] = m[4] = m[8] = 1;
+                m[9] = -a[0];
+                m[10] = -a[1];
+                m[11] = -a[2];
+                return 1;
+            case SdfNodeKind.Scale:
+                m[0] = m[4] = m[8] = 1.0 / a[0];
+                return a[0];
+            case SdfNodeKind.Rotate:
+                Evaluator.RotationMatrix(a[0], Evaluator.Vec(a, 1), m);
+                return 1;
+            default:
+                a.AsSpan(0, 12).CopyTo(m);
+                return a[12];
+        }
+    }
+
+    /// <summary>
+    /// The cell index is piecewise constant, so each instance is the child at a
+    /// shifted point; padded repeats take the minimum over the neighboring instances
+    /// </summary>
+    private static Dual[] Repeat(SDF3 node, Dual[] x, Dual[] y, Dual[] z)
+    {
+        var a = node.Args;
+        int n = x.Length;
+        var padding = (int)a[6];
+        int px = a[0] == 0 ? 0 : padding, py = a[1] == 0 ? 0 : padding, pz = a[2] == 0 ? 0 : padding;
+        var cells = new Vector3[n];
+        for (int i = 0; i < n; i++)
+            cells[i] = new Vector3(Cell(x[i].Value, a[0], a[3]), Cell(y[i].Value, a[1], a[4]), Cell(z[i].Value, a[2], a[5]));
+
+        Dual[]? best = null;
+        var tx = new Dual[n];
+        var ty = new Dual[n];
+        var tz = new Dual[n];
+        for (int i = -px; i <= px; i++)
+        {
+            for (int j = -py; j <= py; j++)
+            {
+                for (int k = -pz; k <= pz; k++)
+                {
+                    for (int p = 0; p < n; p++)
+                    {
+                        tx[p] = x[p] - a[0] * (cells[p].X + i);
+                        ty[p] = y[p] - a[1] * (cells[p].Y + j);
+                        tz[p] = z[p] - a[2] * (cells[p].Z + k);
+                    }
+                    var d = Evaluate(node.Inputs[0], tx, ty, tz);
+                    if (best == null)
+                    {
+                        // Offsets run from the most negative, which may lie outside the array
+                        best = new Dual[n];
+                        Array.Fill(best, new Dual(double.PositiveInfinity));
+                    }
+                    for (int p = 0; p < n; p++)
+                    {
+                        var c = cells[p];
+                        if (Math.Abs(c.X + i) <= a[3] && Math.Abs(c.Y + j) <= a[4] && Math.Abs(c.Z + k) <= a[5])
+                            best[p] = Dual.Min(best[p], d[p]);
+                    }
+                }
+            }
+        }
+        return best!;
+    }
+
+    private static double Cell(double p, double spacing, double count) =>
+        spacing == 0 ? 0 : Math.Round(Math.Clamp(p / spacing, -count, count));
+
+    /// <summary>
+    /// Opaque functions are differentiated by central differences in one call
+    /// over all points, with the result carried through the chain rule
+    /// </summary>
+    private static Dual[] Custom(SDF3 node, Dual[] x, Dual[] y, Dual[] z)
+    {
+        int n = x.Length;
+        var samples = new Vector3[7 * n];
+        var steps = new double[n];
+        for (int i = 0; i < n; i++)
+        {
+            var p = new Vector3(x[i].Value, y[i].Value, z[i].Value);
+            var h = 1e-6 * Math.Max(1.0, Math.Max(Math.Abs(p.X), Math.Max(Math.Abs(p.Y), Math.Abs(p.Z))));
+            steps[i] = h;
+            samples[7 * i] = p;
+            samples[7 * i + 1] = p + new Vector3(h, 0, 0);
+            samples[7 * i + 2] = p - new Vector3(h, 0, 0);
+            samples[7 * i + 3] = p + new Vector3(0, h, 0);
+            samples[7 * i + 4] = p - new Vector3(0, h, 0);
+            samples[7 * i + 5] = p + new Vector3(0, 0, h);
+            samples[7 * i + 6] = p - new Vector3(0, 0, h);
+        }
+        var values = node.Function!(samples);
+
+        var result = new Dual[n];
+        for (int i = 0; i < n; i++)
+        {
+            var v = values.AsSpan(7 * i, 7);
+            var scale = 0.5 / steps[i];
+            double gx = (v[1] - v[2]) * scale, gy = (v[3] - v[4]) * scale, gz = (v[5] - v[6]) * scale;
+            result[i] = new Dual(v[0], x[i].Gradient * gx + y[i].Gradient * gy + z[i].Gradient * gz);
+        }
+        return result;
+    }
+}
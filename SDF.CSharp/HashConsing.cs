@@ -0,0 +1,59 @@
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Hash-consing for SDF3 graphs: structurally identical subtrees are merged into
+/// one instance, turning the tree into a DAG whose shared nodes evaluators can
+/// compute once and reuse.
+/// </summary>
+internal static class HashConsing
+{
+    /// <summary>
+    /// Equivalent graph in which every distinct subtree appears as a single instance
+    /// </summary>
+    public static SDF3 Share(SDF3 root)
+    {
+        var table = new Dictionary<SDF3, SDF3>(StructuralComparer.Instance);
+        return Intern(root, table);
+    }
+
+    private static SDF3 Intern(SDF3 node, Dictionary<SDF3, SDF3> table)
+    {
+        if (table.TryGetValue(node, out var existing))
+            return existing;
+
+        var children = new SDF3[node.Inputs.Length];
+        for (int i = 0; i < children.Length; i++)
+            children[i] = Intern(node.Inputs[i], table);
+
+        var interned = node.WithInputs(children);
+        table[interned] = interned;
+        return interned;
+    }
+
+    /// <summary>
+    /// Inner nodes reached through more than one parent. Leaves are left out:
+    /// they are cheaper to recompute than to cache. Returns null when there are none.
+    /// </summary>
+    public static HashSet<SDF3>? FindShared(SDF3 root)
+    {
+        var seen = new HashSet<SDF3>(ReferenceEqualityComparer.Instance);
+        HashSet<SDF3>? shared = null;
+        var stack = new Stack<SDF3>();
+        stack.Push(root);
+        while (stack.Count > 0)
+        {
+            var node = stack.Pop();
+            if (!seen.Add(node))
+            {
+                if (node.Inputs.Length > 0)
+                    (shared ??= new HashSet<SDF3>(ReferenceEqualityComparer.Instance)).Add(node);
+                continue;
+            }
+            foreach (var child in node.Inputs)
+                stack.Push(child);
+        }
+        return shared;
+    }
+}
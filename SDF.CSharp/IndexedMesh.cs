@@ -0,0 +1,44 @@
+using System;
+
+namespace SDF;
+
+/// <summary>
+/// Triangle mesh with each vertex stored once: x, y, z per vertex in
+/// <see cref="Vertices"/> and three vertex indices per triangle in
+/// <see cref="Indices"/>, counterclockwise seen from outside
+/// </summary>
+public sealed class IndexedMesh
+{
+    public IndexedMesh(float[] vertices, uint[] indices)
+    {
+        if (vertices.Length % 3 != 0)
+            throw new ArgumentException("Vertex buffer length must be divisible by 3", nameof(vertices));
+        if (indices.Length % 3 != 0)
+            throw new ArgumentException("Index count must be divisible by 3", nameof(indices));
+        Vertices = vertices;
+        Indices = indices;
+    }
+
+    public float[] Vertices { get; }
+    public uint[] Indices { get; }
+
+    public int VertexCount => Vertices.Length / 3;
+    public int TriangleCount => Indices.Length / 3;
+
+    /// <summary>
+    /// Vertex at <paramref name="index"/>
+    /// </summary>
+    public Vector3 Vertex(uint index) =>
+        new(Vertices[3 * index], Vertices[3 * index + 1], Vertices[3 * index + 2]);
+
+    /// <summary>
+    /// Expand into triangle soup, three vertices per triangle
+    /// </summary>
+    public Vector3[] ToTriangles()
+    {
+        var triangles = new Vector3[Indices.Length];
+        for (int i = 0; i < Indices.Length; i++)
+            triangles[i] = Vertex(Indices[i]);
+        return triangles;
+    }
+}
@@ -0,0 +1,125 @@
+using System;
+
+namespace SDF;
+
+/// <summary>
+/// Closed range of real numbers [Lo, Hi] used for conservative interval arithmetic.
+/// Every operation returns a range that contains all possible results.
+/// </summary>
+public readonly struct Interval : IEquatable<Interval>
+{
+    public double Lo { get; }
+    public double Hi { get; }
+
+    public Interval(double lo, double hi)
+    {
+        Lo = lo;
+        Hi = hi;
+    }
+
+    public Interval(double value)
+    {
+        Lo = value;
+        Hi = value;
+    }
+
+    /// <summary>
+    /// The whole real line, returned when nothing is known
+    /// </summary>
+    public static readonly Interval Entire = new(double.NegativeInfinity, double.PositiveInfinity);
+
+    public double Width => Hi - Lo;
+    public double Center => 0.5 * (Lo + Hi);
+    public bool IsFinite => double.IsFinite(Lo) && double.IsFinite(Hi);
+
+    public bool Contains(double value) => Lo <= value && value <= Hi;
+
+    public static Interval operator +(Interval a, Interval b) => new(a.Lo + b.Lo, a.Hi + b.Hi);
+    public static Interval operator +(Interval a, double b) => new(a.Lo + b, a.Hi + b);
+    public static Interval operator -(Interval a, Interval b) => new(a.Lo - b.Hi, a.Hi - b.Lo);
+    public static Interval operator -(Interval a, double b) => new(a.Lo - b, a.Hi - b);
+    public static Interval operator -(Interval a) => new(-a.Hi, -a.Lo);
+
+    public static Interval operator *(Interval a, double b) =>
+        b >= 0 ? new(Mul(a.Lo, b), Mul(a.Hi, b)) : new(Mul(a.Hi, b), Mul(a.Lo, b));
+
+    public static Interval operator *(double a, Interval b) => b * a;
+
+    public static Interval operator *(Interval a, Interval b)
+    {
+        var p1 = Mul(a.Lo, b.Lo);
+        var p2 = Mul(a.Lo, b.Hi);
+        var p3 = Mul(a.Hi, b.Lo);
+        var p4 = Mul(a.Hi, b.Hi);
+        return new(Math.Min(Math.Min(p1, p2), Math.Min(p3, p4)), Math.Max(Math.Max(p1, p2), Math.Max(p3, p4)));
+    }
+
+    public static Interval operator /(Interval a, Interval b)
+    {
+        if (b.Contains(0))
+            return Entire;
+        return a * new Interval(1.0 / b.Hi, 1.0 / b.Lo);
+    }
+
+    public static Interval operator /(Interval a, double b) => a * (1.0 / b);
+
+    public static Interval Abs(Interval a)
+    {
+        if (a.Lo >= 0)
+            return a;
+        if (a.Hi <= 0)
+            return -a;
+        return new(0, Math.Max(-a.Lo, a.Hi));
+    }
+
+    public static Interval Square(Interval a)
+    {
+        var m = Abs(a);
+        return new(m.Lo * m.Lo, m.Hi * m.Hi);
+    }
+
+    public static Interval Sqrt(Interval a) =>
+        new(Math.Sqrt(Math.Max(a.Lo, 0)), Math.Sqrt(Math.Max(a.Hi, 0)));
+
+    public static Interval Min(Interval a, Interval b) => new(Math.Min(a.Lo, b.Lo), Math.Min(a.Hi, b.Hi));
+    public static Interval Max(Interval a, Interval b) => new(Math.Max(a.Lo, b.Lo), Math.Max(a.Hi, b.Hi));
+
+    public static Interval Min(Interval a, double b) => new(Math.Min(a.Lo, b), Math.Min(a.Hi, b));
+    public static Interval Max(Interval a, double b) => new(Math.Max(a.Lo, b), Math.Max(a.Hi, b));
+
+    public static Interval Clamp(Interval a, double lo, double hi) => Min(Max(a, lo), hi);
+
+    /// <summary>
+    /// Smallest interval containing both inputs
+    /// </summary>
+    public static Interval Hull(Interval a, Interval b) => new(Math.Min(a.Lo, b.Lo), Math.Max(a.Hi, b.Hi));
+
+    public static Interval Cos(Interval a)
+    {
+        if (!a.IsFinite || a.Width >= 2 * Math.PI)
+            return new(-1, 1);
+
+        var lo = Math.Min(Math.Cos(a.Lo), Math.Cos(a.Hi));
+        var hi = Math.Max(Math.Cos(a.Lo), Math.Cos(a.Hi));
+
+        // Maxima at 2*pi*n, minima at pi + 2*pi*n
+        if (Math.Floor(a.Hi / (2 * Math.PI)) > Math.Floor(a.Lo / (2 * Math.PI)))
+            hi = 1;
+        if (Math.Floor((a.Hi - Math.PI) / (2 * Math.PI)) > Math.Floor((a.Lo - Math.PI) / (2 * Math.PI)))
+            lo = -1;
+        return new(lo, hi);
+    }
+
+    public static Interval Sin(Interval a) => Cos(a - Math.PI / 2);
+
+    /// <summary>
+    /// Product where zero times infinity is zero, as interval bounds require
+    /// </summary>
+    private static double Mul(double a, double b) => a == 0 || b == 0 ? 0 : a * b;
+
+    public bool Equals(Interval other) => Lo.Equals(other.Lo) && Hi.Equals(other.Hi);
+    public override bool Equals(object? obj) => obj is Interval other && Equals(other);
+    public override int GetHashCode() => HashCode.Combine(Lo, Hi);
+
+    public override string ToString() => $"[{Lo:G6}, {Hi:G6}]";
+}
@@ -0,0 +1,537 @@
+using System;
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Evaluates an SDF3 expression graph over axis-aligned boxes with interval
+/// arithmetic. The returned range contains every value the SDF takes inside
+/// the box, so a box whose range excludes zero holds no surface.
+/// </summary>
+internal static class IntervalEvaluator
+{
+    public static Interval Evaluate(SDF3 node, (Vector3 min, Vector3 max) box) =>
+        Evaluate(node, new Interval(box.min.X, box.max.X), new Interval(box.min.Y, box.max.Y), new Interval(box.min.Z, box.max.Z));
+
+    public static Interval Evaluate(SDF3 node, Interval x, Interval y, Interval z)
+    {
+        // Baked subtrees are read from their grid, which strays from the
+        // subtree by its interpolation error
+        if (TieredEvaluation.Grid(node) is { } grid)
+        {
+            var around = new Interval(-grid.Step, grid.Step);
+            var error = grid.Error(LipschitzEvaluator.BoundNode(node, x + around, y + around, z + around));
+            return double.IsFinite(error) ? EvaluateNode(node, x, y, z) + new Interval(-error, error) : Interval.Entire;
+        }
+        return EvaluateNode(node, x, y, z);
+    }
+
+    private static Interval EvaluateNode(SDF3 node, Interval x, Interval y, Interval z)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Custom:
+                return Interval.Entire;
+
+            case SdfNodeKind.Sphere:
+                return Length(x - a[1], y - a[2], z - a[3]) - a[0];
+            case SdfNodeKind.Box:
+                return BoxDistance(
+                    Interval.Abs(x - a[3]) - a[0] / 2.0,
+                    Interval.Abs(y - a[4]) - a[1] / 2.0,
+                    Interval.Abs(z - a[5]) - a[2] / 2.0);
+            case SdfNodeKind.Cylinder:
+                return Interval.Sqrt(Interval.Square(x) + Interval.Square(y)) - a[0];
+            case SdfNodeKind.CappedCylinder:
+                // Exact distance, so it is 1-Lipschitz around the box center
+                return LipschitzRange(node, x, y, z);
+            case SdfNodeKind.Plane:
+                return (x - a[3]) * a[0] + (y - a[4]) * a[1] + (z - a[5]) * a[2];
+            case SdfNodeKind.Torus:
+            {
+                var qx = Interval.Sqrt(Interval.Square(x) + Interval.Square(y)) - a[0];
+                return Interval.Sqrt(Interval.Square(qx) + Interval.Square(z)) - a[1];
+            }
+            case SdfNodeKind.RoundedBox:
+                return BoxDistance(
+                    Interval.Abs(x) - (a[0] / 2.0 - a[3]),
+                    Interval.Abs(y) - (a[1] / 2.0 - a[3]),
+                    Interval.Abs(z) - (a[2] / 2.0 - a[3])) - a[3];
+            case SdfNodeKind.Capsule:
+            {
+                var pa = Evaluator.Vec(a, 0);
+                var ba = Evaluator.Vec(a, 3) - pa;
+                var baba = Vector3.Dot(ba, ba);
+                var pax = x - pa.X;
+                var pay = y - pa.Y;
+                var paz = z - pa.Z;
+                var h = Interval.Clamp((pax * ba.X + pay * ba.Y + paz * ba.Z) / baba, 0, 1);
+                return Length(pax - h * ba.X, pay - h * ba.Y, paz - h * ba.Z) - a[6];
+            }
+            case SdfNodeKind.Ellipsoid:
+            {
+                var k0 = Length(x / a[0], y / a[1], z / a[2]);
+                var k1 = Length(x / (a[0] * a[0]), y / (a[1] * a[1]), z / (a[2] * a[2]));
+                return k0 * (k0 - 1.0) / k1;
+            }
+
+            case SdfNodeKind.Union:
+            case SdfNodeKind.Intersection:
+            case SdfNodeKind.Difference:
+            case SdfNodeKind.SmoothUnion:
+            case SdfNodeKind.SmoothIntersection:
+            case SdfNodeKind.SmoothDifference:
+                return Combine(node, Evaluate(node.Inputs[0], x, y, z), Evaluate(node.Inputs[1], x, y, z));
+            case SdfNodeKind.NaryUnion:
+            {
+                // The blend only lowers the smallest child, by at most k / 4
+                var m = Evaluate(node.Inputs[0], x, y, z);
+                for (int i = 1; i < node.Inputs.Length; i++)
+                    m = Interval.Min(m, Evaluate(node.Inputs[i], x, y, z));
+                return new Interval(m.Lo - a[0] / 4.0, m.Hi);
+            }
+
+            case SdfNodeKind.Translate:
+            case SdfNodeKind.Rotate:
+            case SdfNodeKind.Twist:
+            case SdfNodeKind.Bend:
+            case SdfNodeKind.Repeat:
+            case SdfNodeKind.Scale:
+            case SdfNodeKind.Affine:
+            case SdfNodeKind.Elongate:
+            {
+                var (cx, cy, cz) = MapDomain(node, x, y, z);
+                return MapRange(node, Evaluate(node.Inputs[0], cx, cy, cz), cx, cy, cz);
+            }
+
+            case SdfNodeKind.Dilate:
+            case SdfNodeKind.Erode:
+            case SdfNodeKind.Shell:
+                return MapRange(node, Evaluate(node.Inputs[0], x, y, z), x, y, z);
+
+            default:
+                throw new NotSupportedException($"Unknown SDF node kind {node.Kind}");
+        }
+    }
+
+    /// <summary>
+    /// Specialize a tree to a box: boolean branches that cannot win anywhere in
+    /// the box are dropped, so the returned tree takes exactly the same values
+    /// there. Returns <paramref name="node"/> itself when nothing can be removed.
+    /// </summary>
+    public static SDF3 Prune(SDF3 node, (Vector3 min, Vector3 max) box) =>
+        Prune(node, new Interval(box.min.X, box.max.X), new Interval(box.min.Y, box.max.Y), new Interval(box.min.Z, box.max.Z), out _,
+            SharedMemo<(SDF3, Interval, Interval, Interval), (SDF3, Interval)>.For(node));
+
+    /// <summary>
+    /// Shared subtrees pruned over the same box are pruned once, which also keeps
+    /// them shared in the result
+    /// </summary>
+    private static SDF3 Prune(SDF3 node, Interval x, Interval y, Interval z, out Interval range,
+        SharedMemo<(SDF3, Interval, Interval, Interval), (SDF3, Interval)>? memo)
+    {
+        if (memo == null || !memo.IsShared(node))
+            return PruneNode(node, x, y, z, out range, memo);
+
+        if (!memo.Values.TryGetValue((node, x, y, z), out var cached))
+        {
+            cached = (PruneNode(node, x, y, z, out range, memo), range);
+            memo.Values[(node, x, y, z)] = cached;
+        }
+        var (pruned, prunedRange) = cached;
+        range = prunedRange;
+        return pruned;
+    }
+
+    private static SDF3 PruneNode(SDF3 node, Interval x, Interval y, Interval z, out Interval range,
+        SharedMemo<(SDF3, Interval, Interval, Interval), (SDF3, Interval)>? memo)
+    {
+        // Static subtrees are baked as a whole, so pruned copies would each be baked again
+        if (node.BakeStep != null)
+        {
+            range = Evaluate(node, x, y, z);
+            return node;
+        }
+
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Union:
+            case SdfNodeKind.Intersection:
+            case SdfNodeKind.Difference:
+            case SdfNodeKind.SmoothUnion:
+            case SdfNodeKind.SmoothIntersection:
+            case SdfNodeKind.SmoothDifference:
+            {
+                var left = Prune(node.Inputs[0], x, y, z, out var ra, memo);
+                var right = Prune(node.Inputs[1], x, y, z, out var rb, memo);
+
+                // Smooth blends only reach inputs that are within k of each other
+                var k = node.Kind >= SdfNodeKind.SmoothUnion ? a[0] : 0;
+                switch (node.Kind)
+                {
+                    case SdfNodeKind.Union:
+                    case SdfNodeKind.SmoothUnion:
+                        if (ra.Hi <= rb.Lo - k)
+                        {
+                            range = ra;
+                            return left;
+                        }
+                        if (rb.Hi <= ra.Lo - k)
+                        {
+                            range = rb;
+                            return right;
+                        }
+                        break;
+                    case SdfNodeKind.Intersection:
+                    case SdfNodeKind.SmoothIntersection:
+                        if (ra.Lo >= rb.Hi + k)
+                        {
+                            range = ra;
+                            return left;
+                        }
+                        if (rb.Lo >= ra.Hi + k)
+                        {
+                            range = rb;
+                            return right;
+                        }
+                        break;
+                    default:
+                        if (ra.Lo >= -rb.Lo + k)
+                        {
+                            range = ra;
+                            return left;
+                        }
+                        break;
+                }
+                range = Combine(node, ra, rb);
+                return node.WithInputs(left, right);
+            }
+            case SdfNodeKind.NaryUnion:
+            {
+                var children = new SDF3[node.Inputs.Length];
+                var ranges = new Interval[node.Inputs.Length];
+                var lowest = double.PositiveInfinity;
+                for (int i = 0; i < children.Length; i++)
+                {
+                    children[i] = Prune(node.Inputs[i], x, y, z, out ranges[i], memo);
+                    lowest = Math.Min(lowest, ranges[i].Hi);
+                }
+
+                // Children at least k above some other child everywhere never take part.
+                // The child attaining the lowest bound always does, even when its range
+                // is a single value, so the union never loses all its children.
+                var kept = new List<SDF3>();
+                var m = new Interval(double.PositiveInfinity);
+                for (int i = 0; i < children.Length; i++)
+                {
+                    if (ranges[i].Lo >= lowest + a[0] && ranges[i].Hi != lowest)
+                        continue;
+                    kept.Add(children[i]);
+                    m = Interval.Min(m, ranges[i]);
+                }
+                if (kept.Count == 1)
+                {
+                    range = m;
+                    return kept[0];
+                }
+                range = new Interval(m.Lo - a[0] / 4.0, m.Hi);
+                return node.WithInputs(kept.ToArray());
+            }
+
+            case SdfNodeKind.Repeat:
+                // Inside a single cell the repeat is just the instances that can reach it
+                if (HomeCell(a[0], a[3], x, out var ix) && HomeCell(a[1], a[4], y, out var iy) && HomeCell(a[2], a[5], z, out var iz))
+                    return PruneInstances(node, ix, iy, iz, x, y, z, out range, memo);
+                goto case SdfNodeKind.Translate;
+
+            case SdfNodeKind.Translate:
+            case SdfNodeKind.Rotate:
+            case SdfNodeKind.Twist:
+            case SdfNodeKind.Bend:
+            case SdfNodeKind.Scale:
+            case SdfNodeKind.Affine:
+            case SdfNodeKind.Elongate:
+            {
+                var (cx, cy, cz) = MapDomain(node, x, y, z);
+                var child = Prune(node.Inputs[0], cx, cy, cz, out var rc, memo);
+                range = MapRange(node, rc, cx, cy, cz);
+                return node.WithInputs(child);
+            }
+
+            case SdfNodeKind.Dilate:
+            case SdfNodeKind.Erode:
+            case SdfNodeKind.Shell:
+            {
+                var child = Prune(node.Inputs[0], x, y, z, out var rc, memo);
+                range = MapRange(node, rc, x, y, z);
+                return node.WithInputs(child);
+            }
+
+            default:
+                range = Evaluate(node, x, y, z);
+                return node;
+        }
+    }
+
+    /// <summary>
+    /// Cell index every coordinate in <paramref name="p"/> falls in along a repeated
+    /// axis, if they all fall in the same one
+    /// </summary>
+    private static bool HomeCell(double spacing, double count, Interval p, out double index)
+    {
+        index = 0;
+        if (spacing == 0)
+            return true;
+        if (!p.IsFinite)
+            return false;
+        index = Math.Round(Math.Clamp(p.Lo / spacing, -count, count));
+        return index == Math.Round(Math.Clamp(p.Hi / spacing, -count, count));
+    }
+
+    /// <summary>
+    /// Rewrite a repeat over a box inside cell (ix, iy, iz) as the union of the
+    /// translated instances, among that cell's and its padding neighbors', that
+    /// can be the closest somewhere in the box
+    /// </summary>
+    private static SDF3 PruneInstances(SDF3 node, double ix, double iy, double iz, Interval x, Interval y, Interval z,
+        out Interval range, SharedMemo<(SDF3, Interval, Interval, Interval), (SDF3, Interval)>? memo)
+    {
+        var a = node.Args;
+        var padding = (int)a[6];
+        int px = a[0] == 0 ? 0 : padding, py = a[1] == 0 ? 0 : padding, pz = a[2] == 0 ? 0 : padding;
+        var instances = new List<(SDF3 sdf, Interval range)>();
+        var lowest = double.PositiveInfinity;
+        for (int i = -px; i <= px; i++)
+        {
+            for (int j = -py; j <= py; j++)
+            {
+                for (int k = -pz; k <= pz; k++)
+                {
+                    double jx = ix + i, jy = iy + j, jz = iz + k;
+                    if (Math.Abs(jx) > a[3] || Math.Abs(jy) > a[4] || Math.Abs(jz) > a[5])
+                        continue;
+                    var offset = new Vector3(a[0] * jx, a[1] * jy, a[2] * jz);
+                    var child = Prune(node.Inputs[0], x - offset.X, y - offset.Y, z - offset.Z, out var rc, memo);
+                    if (offset.X != 0 || offset.Y != 0 || offset.Z != 0)
+                        child = new SDF3(SdfNodeKind.Translate, new[] { offset.X, offset.Y, offset.Z }, child);
+                    instances.Add((child, rc));
+                    lowest = Math.Min(lowest, rc.Hi);
+                }
+            }
+        }
+
+        // Instances at least as far as the nearest one is at its farthest never win
+        SDF3? result = null;
+        range = new Interval(double.PositiveInfinity);
+        foreach (var (sdf, r) in instances)
+        {
+            if (r.Lo >= lowest && r.Hi != lowest)
+                continue;
+            result = result == null ? sdf : new SDF3(SdfNodeKind.Union, Array.Empty<double>(), result, sdf);
+            range = Interval.Min(range, r);
+        }
+        return result!;
+    }
+
+    /// <summary>
+    /// Whether a box may hold part of the surface. Boxes whose range straddles
+    /// zero are split into octants, up to <paramref name="depth"/> levels, until
+    /// every piece is proven empty or one piece stays inconclusive.
+    /// </summary>
+    public static bool MayContainSurface(SDF3 node, (Vector3 min, Vector3 max) box, int depth)
+    {
+        var range = Evaluate(node, box);
+        if (range.Lo > 0 || range.Hi < 0)
+            return false;
+        if (depth == 0)
+            return true;
+
+        var (min, max) = box;
+        var center = (min + max) * 0.5;
+        for (int i = 0; i < 8; i++)
+        {
+            var lo = new Vector3(
+                (i & 1) == 0 ? min.X : center.X,
+                (i & 2) == 0 ? min.Y : center.Y,
+                (i & 4) == 0 ? min.Z : center.Z);
+            var hi = new Vector3(
+                (i & 1) == 0 ? center.X : max.X,
+                (i & 2) == 0 ? center.Y : max.Y,
+                (i & 4) == 0 ? center.Z : max.Z);
+            if (MayContainSurface(node, (lo, hi), depth - 1))
+                return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Map a box in a domain-transform node's space to a box containing
+    /// every point its child is evaluated at
+    /// </summary>
+    public static (Interval x, Interval y, Interval z) MapDomain(SDF3 node, Interval x, Interval y, Interval z)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Translate:
+                return (x - a[0], y - a[1], z - a[2]);
+            case SdfNodeKind.Scale:
+                return (x / a[0], y / a[0], z / a[0]);
+            case SdfNodeKind.Rotate:
+            {
+                Span<double> m = stackalloc double[9];
+                Evaluator.RotationMatrix(a[0], Evaluator.Vec(a, 1), m);
+                return (
+                    x * m[0] + y * m[1] + z * m[2],
+                    x * m[3] + y * m[4] + z * m[5],
+                    x * m[6] + y * m[7] + z * m[8]);
+            }
+            case SdfNodeKind.Affine:
+                return (
+                    x * a[0] + y * a[1] + z * a[2] + a[9],
+                    x * a[3] + y * a[4] + z * a[5] + a[10],
+                    x * a[6] + y * a[7] + z * a[8] + a[11]);
+            case SdfNodeKind.Twist:
+            case SdfNodeKind.Bend:
+            {
+                var angle = (node.Kind == SdfNodeKind.Twist ? z : x) * a[0];
+                var c = Interval.Cos(angle);
+                var s = Interval.Sin(angle);
+
+                // Rotation keeps the XY radius, which also bounds both outputs
+                var r = Math.Sqrt(Interval.Square(x).Hi + Interval.Square(y).Hi);
+                var tx = c * x - s * y;
+                var ty = s * x + c * y;
+                return (
+                    new Interval(Math.Max(tx.Lo, -r), Math.Min(tx.Hi, r)),
+                    new Interval(Math.Max(ty.Lo, -r), Math.Min(ty.Hi, r)),
+                    z);
+            }
+            case SdfNodeKind.Elongate:
+                return (ElongateAxis(x, a[0]), ElongateAxis(y, a[1]), ElongateAxis(z, a[2]));
+            case SdfNodeKind.Repeat:
+                return (RepeatAxis(x, a[0], a[3], a[6]), RepeatAxis(y, a[1], a[4], a[6]), RepeatAxis(z, a[2], a[5], a[6]));
+            default:
+                return (x, y, z);
+        }
+    }
+
+    /// <summary>
+    /// Range of a boolean node given the ranges of its two inputs
+    /// </summary>
+    private static Interval Combine(SDF3 node, Interval ra, Interval rb)
+    {
+        var k = node.Kind >= SdfNodeKind.SmoothUnion ? node.Args[0] : 0;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Union:
+                return Interval.Min(ra, rb);
+            case SdfNodeKind.Intersection:
+                return Interval.Max(ra, rb);
+            case SdfNodeKind.Difference:
+                return Interval.Max(ra, -rb);
+            case SdfNodeKind.SmoothUnion:
+            {
+                // The blend only ever lowers min(a, b), by at most k / 4
+                var m = Interval.Min(ra, rb);
+                return new Interval(m.Lo - k / 4.0, m.Hi);
+            }
+            case SdfNodeKind.SmoothIntersection:
+            {
+                var m = Interval.Max(ra, rb);
+                return new Interval(m.Lo, m.Hi + k / 4.0);
+            }
+            default:
+            {
+                var m = Interval.Max(ra, -rb);
+                return new Interval(m.Lo, m.Hi + k / 4.0);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Range of a single-child node given its child's range over the mapped box
+    /// </summary>
+    private static Interval MapRange(SDF3 node, Interval child, Interval cx, Interval cy, Interval cz)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Scale:
+                return child * a[0];
+            case SdfNodeKind.Affine:
+                return child * a[12];
+            case SdfNodeKind.Elongate:
+                return child + Length(Interval.Abs(cx), Interval.Abs(cy), Interval.Abs(cz));
+            case SdfNodeKind.Dilate:
+                return child - a[0];
+            case SdfNodeKind.Erode:
+                return child + a[0];
+            case SdfNodeKind.Shell:
+                return Interval.Abs(child) - a[0];
+            default:
+                return child;
+        }
+    }
+
+    private static Interval Length(Interval x, Interval y, Interval z) =>
+        Interval.Sqrt(Interval.Square(x) + Interval.Square(y) + Interval.Square(z));
+
+    private static Interval BoxDistance(Interval qx, Interval qy, Interval qz)
+    {
+        var outside = Length(Interval.Max(qx, 0), Interval.Max(qy, 0), Interval.Max(qz, 0));
+        var inside = Interval.Min(Interval.Max(qx, Interval.Max(qy, qz)), 0);
+        return outside + inside;
+    }
+
+    /// <summary>
+    /// Range of a 1-Lipschitz node over a box: its value at the center plus or
+    /// minus the distance from the center to the farthest corner
+    /// </summary>
+    private static Interval LipschitzRange(SDF3 node, Interval x, Interval y, Interval z)
+    {
+        if (!x.IsFinite || !y.IsFinite || !z.IsFinite)
+            return Interval.Entire;
+        var center = new Vector3(x.Center, y.Center, z.Center);
+        var d = Evaluator.Evaluate(node, new[] { center })[0];
+        var r = 0.5 * Math.Sqrt(x.Width * x.Width + y.Width * y.Width + z.Width * z.Width);
+        return new Interval(d - r, d + r);
+    }
+
+    /// <summary>
+    /// sign(p) * max(|p| - s, 0), which equals p - clamp(p, -s, s) and is monotone
+    /// </summary>
+    private static Interval ElongateAxis(Interval p, double s) =>
+        new(p.Lo - Math.Clamp(p.Lo, -s, s), p.Hi - Math.Clamp(p.Hi, -s, s));
+
+    /// <summary>
+    /// Coordinates the child sees along one axis, widened by the neighboring
+    /// cells a padded repeat also evaluates
+    /// </summary>
+    private static Interval RepeatAxis(Interval p, double spacing, double count, double padding)
+    {
+        var reach = Math.Abs(spacing) * padding;
+        var q = RepeatAxis(p, spacing, count);
+        return reach == 0 ? q : new Interval(q.Lo - reach, q.Hi + reach);
+    }
+
+    private static Interval RepeatAxis(Interval p, double spacing, double count)
+    {
+        if (spacing == 0)
+            return p;
+        if (!p.IsFinite)
+            return double.IsInfinity(count) ? new Interval(-spacing / 2, spacing / 2) : Interval.Entire;
+
+        var first = Math.Round(Math.Clamp(p.Lo / spacing, -count, count));
+        var last = Math.Round(Math.Clamp(p.Hi / spacing, -count, count));
+        if (first == last)
+            return p - spacing * first;
+
+        // The first and last cells are partially covered, every cell in between fully
+        return new Interval(
+            Math.Min(p.Lo - spacing * first, -spacing / 2),
+            Math.Max(p.Hi - spacing * last, spacing / 2));
+    }
+}
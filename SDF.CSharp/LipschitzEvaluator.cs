@@ -0,0 +1,119 @@
+using System;
+
+namespace SDF;
+
+/// <summary>
+/// Bounds the gradient magnitude of an SDF3 expression graph. A field with
+/// Lipschitz constant L changes by at most L times the distance moved, so a
+/// sample of value d proves there is no surface within |d| / L of it.
+/// </summary>
+internal static class LipschitzEvaluator
+{
+    public static double Bound(SDF3 node, (Vector3 min, Vector3 max) box) =>
+        Bound(node, new Interval(box.min.X, box.max.X), new Interval(box.min.Y, box.max.Y), new Interval(box.min.Z, box.max.Z));
+
+    /// <summary>
+    /// Lipschitz constant of a node over the box x * y * z. Deformations whose
+    /// stretch grows with distance from the axis are only bounded over finite boxes.
+    /// </summary>
+    public static double Bound(SDF3 node, Interval x, Interval y, Interval z)
+    {
+        // Trilinear interpolation changes along each axis by at most as much as
+        // the samples it blends, so a baked grid is bounded by √3 times the
+        // subtree over the cells around the box
+        if (TieredEvaluation.Grid(node) is { } grid)
+        {
+            var around = new Interval(-grid.Step, grid.Step);
+            return Math.Sqrt(3) * BoundNode(node, x + around, y + around, z + around);
+        }
+        return BoundNode(node, x, y, z);
+    }
+
+    /// <summary>
+    /// Lipschitz constant of a node over the box as evaluated exactly, ignoring
+    /// any grid it is baked into
+    /// </summary>
+    public static double BoundNode(SDF3 node, Interval x, Interval y, Interval z)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Custom:
+                // Declared by whoever wrote the function
+                return a[0];
+
+            case SdfNodeKind.Ellipsoid:
+            {
+                // The bound-based approximation stretches with the axis ratio and its
+                // gradient blows up towards the center, where it is discontinuous
+                var longest = Math.Max(a[0], Math.Max(a[1], a[2]));
+                var ratio = longest / Math.Min(a[0], Math.Min(a[1], a[2]));
+                var nearest = Math.Sqrt(Interval.Square(x).Lo + Interval.Square(y).Lo + Interval.Square(z).Lo);
+                return ratio * (1 + longest / nearest);
+            }
+            case SdfNodeKind.Sphere:
+            case SdfNodeKind.Box:
+            case SdfNodeKind.Cylinder:
+            case SdfNodeKind.CappedCylinder:
+            case SdfNodeKind.Plane:
+            case SdfNodeKind.Torus:
+            case SdfNodeKind.RoundedBox:
+            case SdfNodeKind.Capsule:
+                return 1;
+
+            // Hard and polynomial smooth booleans both have gradients that are
+            // convex combinations of their inputs' gradients
+            case SdfNodeKind.Union:
+            case SdfNodeKind.Intersection:
+            case SdfNodeKind.Difference:
+            case SdfNodeKind.SmoothUnion:
+            case SdfNodeKind.SmoothIntersection:
+            case SdfNodeKind.SmoothDifference:
+                return Math.Max(Bound(node.Inputs[0], x, y, z), Bound(node.Inputs[1], x, y, z));
+            case SdfNodeKind.NaryUnion:
+            {
+                double bound = 0;
+                foreach (var child in node.Inputs)
+                    bound = Math.Max(bound, Bound(child, x, y, z));
+                return bound;
+            }
+
+            case SdfNodeKind.Translate:
+            case SdfNodeKind.Rotate:
+            case SdfNodeKind.Scale:
+            case SdfNodeKind.Affine:
+            case SdfNodeKind.Repeat:
+            {
+                // Rigid motions and uniform scaling (which rescales the distance back)
+                // preserve the constant; repeat assumes the child fits in its cell
+                var (cx, cy, cz) = IntervalEvaluator.MapDomain(node, x, y, z);
+                return Bound(node.Inputs[0], cx, cy, cz);
+            }
+            case SdfNodeKind.Twist:
+            case SdfNodeKind.Bend:
+            {
+                // The Jacobian is a rotation plus a shear of k times the XY radius
+                var (cx, cy, cz) = IntervalEvaluator.MapDomain(node, x, y, z);
+                var shear = a[0] == 0 ? 0 : Math.Abs(a[0]) * Math.Sqrt(Interval.Square(x).Hi + Interval.Square(y).Hi);
+                var stretch = node.Kind == SdfNodeKind.Twist
+                    ? 0.5 * (shear + Math.Sqrt(shear * shear + 4))
+                    : 1 + shear;
+                return stretch * Bound(node.Inputs[0], cx, cy, cz);
+            }
+            case SdfNodeKind.Elongate:
+            {
+                // The child's distance plus the 1-Lipschitz length of the clamped offset
+                var (cx, cy, cz) = IntervalEvaluator.MapDomain(node, x, y, z);
+                return Bound(node.Inputs[0], cx, cy, cz) + 1;
+            }
+
+            case SdfNodeKind.Dilate:
+            case SdfNodeKind.Erode:
+            case SdfNodeKind.Shell:
+                return Bound(node.Inputs[0], x, y, z);
+
+            default:
+                throw new NotSupportedException($"Unknown SDF node kind {node.Kind}");
+        }
+    }
+}
@@ -5,154 +5,487 @@ using System.Numerics;
 namespace SDF;
 
 /// <summary>
-/// Simplified marching cubes implementation for mesh generation
-/// Uses a surface net approach for simplicity while maintaining quality
+/// Table-driven marching cubes. Each of the 256 inside/outside patterns of a
+/// cell's corners maps to a fixed set of triangles between the cell's edges.
+/// Ambiguous faces always separate their inside corners, so neighboring cells
+/// agree on every shared face and the surface is closed. Each edge crossing is
+/// interpolated once and cached for the cells around it.
 /// </summary>
 public static class MarchingCubes
 {
     /// <summary>
-    /// Generate mesh triangles from a volume using a simplified surface extraction
+    /// Generate mesh triangles from a volume, three vertices per triangle,
+    /// wound counterclockwise seen from outside. Samples below zero are inside.
+    /// The volume may hold float or double samples.
     /// </summary>
-    public static List<Vector3> Generate(double[,,] volume, Vector3 origin, Vector3 scale)
+    public static List<Vector3> Generate<T>(T[,,] volume, Vector3 origin, Vector3 scale)
+        where T : unmanaged, INumberBase<T>
+    {
+        var mesh = new BatchMesh();
+        Generate(volume, origin, scale, mesh);
+        var triangles = new List<Vector3>();
+        mesh.AppendTriangles(triangles);
+        return triangles;
+    }
+
+    /// <summary>
+    /// Mesh a volume into <paramref name="mesh"/>, each vertex once with the
+    /// lattice edge it lies on
+    /// </summary>
+    internal static void Generate<T>(T[,,] volume, Vector3 origin, Vector3 scale, BatchMesh mesh)
+        where T : unmanaged, INumberBase<T>
     {
-        var vertices = new List<Vector3>();
         int sizeX = volume.GetLength(0);
         int sizeY = volume.GetLength(1);
         int sizeZ = volume.GetLength(2);
+        if (sizeX < 2 || sizeY < 2 || sizeZ < 2)
+            return;
+
+        // Cells are visited one slab between sample planes x and x + 1 at a time,
+        // z fastest as the volume is laid out. Each plane keeps its samples and
+        // the vertices on its y and z edges; the slab keeps those on its x edges.
+        int plane = sizeY * sizeZ;
+        double[] values0 = new double[plane], values1 = new double[plane];
+        int[] yEdges0 = new int[plane], zEdges0 = new int[plane];
+        int[] yEdges1 = new int[plane], zEdges1 = new int[plane];
+        var xEdges = new int[plane];
+        var edges = new int[12];
 
-        // Use a surface nets approach - simpler than full marching cubes
-        // but still produces good quality meshes
+        LoadPlane(volume, 0, values0);
+        PlaneEdges(values0, 0, sizeY, sizeZ, origin, scale, mesh, yEdges0, zEdges0);
         for (int x = 0; x < sizeX - 1; x++)
         {
+            LoadPlane(volume, x + 1, values1);
+            PlaneEdges(values1, x + 1, sizeY, sizeZ, origin, scale, mesh, yEdges1, zEdges1);
+            SlabEdges(values0, values1, x, sizeY, sizeZ, origin, scale, mesh, xEdges);
+
             for (int y = 0; y < sizeY - 1; y++)
             {
+                // Corners 4-7 of one cell are corners 0-3 of the next one up in z
+                int j = y * sizeZ;
+                int top = Corners(values0, values1, j, sizeZ);
                 for (int z = 0; z < sizeZ - 1; z++)
                 {
-                    // Check each face of the current cell for sign changes
-                    var v000 = volume[x, y, z];
-                    var v100 = volume[x + 1, y, z];
-                    var v010 = volume[x, y + 1, z];
-                    var v110 = volume[x + 1, y + 1, z];
-                    var v001 = volume[x, y, z + 1];
-                    var v101 = volume[x + 1, y, z + 1];
-                    var v011 = volume[x, y + 1, z + 1];
-                    var v111 = volume[x + 1, y + 1, z + 1];
-
-                    // Count sign changes across the cube
-                    int signChanges = 0;
-                    if ((v000 < 0) != (v100 < 0)) signChanges++;
-                    if ((v000 < 0) != (v010 < 0)) signChanges++;
-                    if ((v000 < 0) != (v001 < 0)) signChanges++;
-                    if ((v100 < 0) != (v110 < 0)) signChanges++;
-                    if ((v100 < 0) != (v101 < 0)) signChanges++;
-                    if ((v010 < 0) != (v110 < 0)) signChanges++;
-                    if ((v010 < 0) != (v011 < 0)) signChanges++;
-                    if ((v001 < 0) != (v101 < 0)) signChanges++;
-                    if ((v001 < 0) != (v011 < 0)) signChanges++;
-                    if ((v110 < 0) != (v111 < 0)) signChanges++;
-                    if ((v101 < 0) != (v111 < 0)) signChanges++;
-                    if ((v011 < 0) != (v111 < 0)) signChanges++;
-
-                    if (signChanges == 0)
+                    int i = j + z;
+                    int bottom = top;
+                    top = Corners(values0, values1, i + 1, sizeZ);
+                    int cube = bottom | top << 4;
+                    if (cube == 0 || cube == 255)
                         continue;
 
-                    // Calculate surface position using interpolation
-                    var surfacePos = new Vector3(x + 0.5, y + 0.5, z + 0.5);
-                    
-                    // Adjust position based on gradient (simple approximation)
-                    double sumValues = v000 + v100 + v010 + v110 + v001 + v101 + v011 + v111;
-                    double avgValue = sumValues / 8.0;
-                    
-                    if (Math.Abs(avgValue) > 1e-6)
+                    // Only the edges the table refers to for this case hold vertices
+                    edges[0] = xEdges[i];
+                    edges[1] = yEdges1[i];
+                    edges[2] = xEdges[i + sizeZ];
+                    edges[3] = yEdges0[i];
+                    edges[4] = xEdges[i + 1];
+                    edges[5] = yEdges1[i + 1];
+                    edges[6] = xEdges[i + sizeZ + 1];
+                    edges[7] = yEdges0[i + 1];
+                    edges[8] = zEdges0[i];
+                    edges[9] = zEdges1[i];
+                    edges[10] = zEdges1[i + sizeZ];
+                    edges[11] = zEdges0[i + sizeZ];
+                    for (int t = cube * 16; TriangleTable[t] >= 0; t++)
                     {
-                        var offset = 0.3 * avgValue; // Adjust toward surface
-                        surfacePos = new Vector3(
-                            x + 0.5 + offset,
-                            y + 0.5 + offset,
-                            z + 0.5 + offset
-                        );
+                        mesh.Indices.Add(edges[TriangleTable[t]]);
                     }
+                }
+            }
 
-                    // Transform to world space
-                    var worldPos = origin + new Vector3(
-                        surfacePos.X * scale.X,
-                        surfacePos.Y * scale.Y,
-                        surfacePos.Z * scale.Z
-                    );
+            (values0, values1) = (values1, values0);
+            (yEdges0, yEdges1) = (yEdges1, yEdges0);
+            (zEdges0, zEdges1) = (zEdges1, zEdges0);
+        }
+    }
 
-                    // Generate triangles based on which edges have sign changes
-                    // X-direction face
-                    if ((v000 < 0) != (v100 < 0))
-                    {
-                        var p0 = Interpolate(origin + new Vector3(x * scale.X, y * scale.Y, z * scale.Z),
-                                           origin + new Vector3((x + 1) * scale.X, y * scale.Y, z * scale.Z),
-                                           v000, v100);
-                        var p1 = Interpolate(origin + new Vector3(x * scale.X, (y + 1) * scale.Y, z * scale.Z),
-                                           origin + new Vector3((x + 1) * scale.X, (y + 1) * scale.Y, z * scale.Z),
-                                           v010, v110);
-                        var p2 = Interpolate(origin + new Vector3(x * scale.X, y * scale.Y, (z + 1) * scale.Z),
-                                           origin + new Vector3((x + 1) * scale.X, y * scale.Y, (z + 1) * scale.Z),
-                                           v001, v101);
-
-                        vertices.Add(p0);
-                        vertices.Add(p1);
-                        vertices.Add(p2);
-                    }
+    /// <summary>
+    /// Inside bits of the four corners at sample <paramref name="i"/> of planes x
+    /// and x + 1, in the order corners 0-3 take around a cell's z = 0 face
+    /// </summary>
+    private static int Corners(double[] values0, double[] values1, int i, int sizeZ)
+    {
+        int bits = 0;
+        if (values0[i] < 0) bits |= 1;
+        if (values1[i] < 0) bits |= 2;
+        if (values1[i + sizeZ] < 0) bits |= 4;
+        if (values0[i + sizeZ] < 0) bits |= 8;
+        return bits;
+    }
 
-                    // Y-direction face
-                    if ((v000 < 0) != (v010 < 0))
-                    {
-                        var p0 = Interpolate(origin + new Vector3(x * scale.X, y * scale.Y, z * scale.Z),
-                                           origin + new Vector3(x * scale.X, (y + 1) * scale.Y, z * scale.Z),
-                                           v000, v010);
-                        var p1 = Interpolate(origin + new Vector3((x + 1) * scale.X, y * scale.Y, z * scale.Z),
-                                           origin + new Vector3((x + 1) * scale.X, (y + 1) * scale.Y, z * scale.Z),
-                                           v100, v110);
-                        var p2 = Interpolate(origin + new Vector3(x * scale.X, y * scale.Y, (z + 1) * scale.Z),
-                                           origin + new Vector3(x * scale.X, (y + 1) * scale.Y, (z + 1) * scale.Z),
-                                           v001, v011);
-
-                        vertices.Add(p0);
-                        vertices.Add(p2);
-                        vertices.Add(p1);
-                    }
+    private static void LoadPlane<T>(T[,,] volume, int x, double[] values)
+        where T : unmanaged, INumberBase<T>
+    {
+        int sizeY = volume.GetLength(1), sizeZ = volume.GetLength(2);
+        for (int y = 0, i = 0; y < sizeY; y++)
+        {
+            for (int z = 0; z < sizeZ; z++, i++)
+            {
+                values[i] = double.CreateTruncating(volume[x, y, z]);
+            }
+        }
+    }
 
-                    // Z-direction face
-                    if ((v000 < 0) != (v001 < 0))
-                    {
-                        var p0 = Interpolate(origin + new Vector3(x * scale.X, y * scale.Y, z * scale.Z),
-                                           origin + new Vector3(x * scale.X, y * scale.Y, (z + 1) * scale.Z),
-                                           v000, v001);
-                        var p1 = Interpolate(origin + new Vector3((x + 1) * scale.X, y * scale.Y, z * scale.Z),
-                                           origin + new Vector3((x + 1) * scale.X, y * scale.Y, (z + 1) * scale.Z),
-                                           v100, v101);
-                        var p2 = Interpolate(origin + new Vector3(x * scale.X, (y + 1) * scale.Y, z * scale.Z),
-                                           origin + new Vector3(x * scale.X, (y + 1) * scale.Y, (z + 1) * scale.Z),
-                                           v010, v011);
-
-                        vertices.Add(p0);
-                        vertices.Add(p1);
-                        vertices.Add(p2);
-                    }
+    /// <summary>
+    /// Vertices where the surface crosses the y and z edges of sample plane <paramref name="x"/>
+    /// </summary>
+    private static void PlaneEdges(double[] values, int x, int sizeY, int sizeZ, Vector3 origin, Vector3 scale,
+        BatchMesh mesh, int[] yEdges, int[] zEdges)
+    {
+        long first = (long)x * sizeY * sizeZ;
+        for (int y = 0; y < sizeY; y++)
+        {
+            for (int z = 0; z < sizeZ; z++)
+            {
+                int i = y * sizeZ + z;
+                var v = values[i];
+                if (z + 1 < sizeZ && (v < 0) != (values[i + 1] < 0))
+                {
+                    zEdges[i] = Add(mesh, Vertex(origin, scale, x, y, z + Crossing(v, values[i + 1])), (first + i) * 3 + 2);
+                }
+                if (y + 1 < sizeY && (v < 0) != (values[i + sizeZ] < 0))
+                {
+                    yEdges[i] = Add(mesh, Vertex(origin, scale, x, y + Crossing(v, values[i + sizeZ]), z), (first + i) * 3 + 1);
                 }
             }
         }
-
-        return vertices;
     }
 
     /// <summary>
-    /// Linear interpolation between two points based on SDF values
+    /// Vertices where the surface crosses the x edges between planes <paramref name="x"/> and x + 1
     /// </summary>
-    private static Vector3 Interpolate(Vector3 p0, Vector3 p1, double v0, double v1)
+    private static void SlabEdges(double[] values0, double[] values1, int x, int sizeY, int sizeZ, Vector3 origin, Vector3 scale,
+        BatchMesh mesh, int[] xEdges)
     {
-        if (Math.Abs(v0 - v1) < 1e-6)
-            return (p0 + p1) * 0.5;
-
-        double t = -v0 / (v1 - v0);
-        t = Math.Max(0.0, Math.Min(1.0, t));
+        long first = (long)x * sizeY * sizeZ;
+        for (int y = 0; y < sizeY; y++)
+        {
+            for (int z = 0; z < sizeZ; z++)
+            {
+                int i = y * sizeZ + z;
+                if ((values0[i] < 0) != (values1[i] < 0))
+                {
+                    xEdges[i] = Add(mesh, Vertex(origin, scale, x + Crossing(values0[i], values1[i]), y, z), (first + i) * 3);
+                }
+            }
+        }
+    }
 
-        return p0 + (p1 - p0) * t;
+    private static int Add(BatchMesh mesh, Vector3 vertex, long edge)
+    {
+        mesh.Vertices.Add(vertex);
+        mesh.Keys.Add(edge);
+        return mesh.Vertices.Count - 1;
     }
-}
 
+    /// <summary>
+    /// Fraction of the way from a sample of value <paramref name="v0"/> to its
+    /// neighbor of value <paramref name="v1"/> where the linear interpolant is zero.
+    /// The two have opposite signs, so the denominator is never zero.
+    /// </summary>
+    private static double Crossing(double v0, double v1) => v0 / (v0 - v1);
+
+    private static Vector3 Vertex(Vector3 origin, Vector3 scale, double x, double y, double z) =>
+        new(origin.X + x * scale.X, origin.Y + y * scale.Y, origin.Z + z * scale.Z);
+
+    // Edges crossed by the surface for each case, as a bit mask. Corners are
+    // numbered 0-3 counterclockwise around the z = 0 face from the origin and
+    // 4-7 above them; edges 0-3 run around the bottom face, 4-7 around the top
+    // face, and 8-11 upward from corners 0-3.
+    private static readonly ushort[] EdgeTable =
+    {
+        0x000, 0x109, 0x203, 0x30a, 0x406, 0x50f, 0x605, 0x70c,
+        0x80c, 0x905, 0xa0f, 0xb06, 0xc0a, 0xd03, 0xe09, 0xf00,
+        0x190, 0x099, 0x393, 0x29a, 0x596, 0x49f, 0x795, 0x69c,
+        0x99c, 0x895, 0xb9f, 0xa96, 0xd9a, 0xc93, 0xf99, 0xe90,
+        0x230, 0x339, 0x033, 0x13a, 0x636, 0x73f, 0x435, 0x53c,
+        0xa3c, 0xb35, 0x83f, 0x936, 0xe3a, 0xf33, 0xc39, 0xd30,
+        0x3a0, 0x2a9, 0x1a3, 0x0aa, 0x7a6, 0x6af, 0x5a5, 0x4ac,
+        0xbac, 0xaa5, 0x9af, 0x8a6, 0xfaa, 0xea3, 0xda9, 0xca0,
+        0x460, 0x569, 0x663, 0x76a, 0x066, 0x16f, 0x265, 0x36c,
+        0xc6c, 0xd65, 0xe6f, 0xf66, 0x86a, 0x963, 0xa69, 0xb60,
+        0x5f0, 0x4f9, 0x7f3, 0x6fa, 0x1f6, 0x0ff, 0x3f5, 0x2fc,
+        0xdfc, 0xcf5, 0xfff, 0xef6, 0x9fa, 0x8f3, 0xbf9, 0xaf0,
+        0x650, 0x759, 0x453, 0x55a, 0x256, 0x35f, 0x055, 0x15c,
+        0xe5c, 0xf55, 0xc5f, 0xd56, 0xa5a, 0xb53, 0x859, 0x950,
+        0x7c0, 0x6c9, 0x5c3, 0x4ca, 0x3c6, 0x2cf, 0x1c5, 0x0cc,
+        0xfcc, 0xec5, 0xdcf, 0xcc6, 0xbca, 0xac3, 0x9c9, 0x8c0,
+        0x8c0, 0x9c9, 0xac3, 0xbca, 0xcc6, 0xdcf, 0xec5, 0xfcc,
+        0x0cc, 0x1c5, 0x2cf, 0x3c6, 0x4ca, 0x5c3, 0x6c9, 0x7c0,
+        0x950, 0x859, 0xb53, 0xa5a, 0xd56, 0xc5f, 0xf55, 0xe5c,
+        0x15c, 0x055, 0x35f, 0x256, 0x55a, 0x453, 0x759, 0x650,
+        0xaf0, 0xbf9, 0x8f3, 0x9fa, 0xef6, 0xfff, 0xcf5, 0xdfc,
+        0x2fc, 0x3f5, 0x0ff, 0x1f6, 0x6fa, 0x7f3, 0x4f9, 0x5f0,
+        0xb60, 0xa69, 0x963, 0x86a, 0xf66, 0xe6f, 0xd65, 0xc6c,
+        0x36c, 0x265, 0x16f, 0x066, 0x76a, 0x663, 0x569, 0x460,
+        0xca0, 0xda9, 0xea3, 0xfaa, 0x8a6, 0x9af, 0xaa5, 0xbac,
+        0x4ac, 0x5a5, 0x6af, 0x7a6, 0x0aa, 0x1a3, 0x2a9, 0x3a0,
+        0xd30, 0xc39, 0xf33, 0xe3a, 0x936, 0x83f, 0xb35, 0xa3c,
+        0x53c, 0x435, 0x73f, 0x636, 0x13a, 0x033, 0x339, 0x230,
+        0xe90, 0xf99, 0xc93, 0xd9a, 0xa96, 0xb9f, 0x895, 0x99c,
+        0x69c, 0x795, 0x49f, 0x596, 0x29a, 0x393, 0x099, 0x190,
+        0xf00, 0xe09, 0xd03, 0xc0a, 0xb06, 0xa0f, 0x905, 0x80c,
+        0x70c, 0x605, 0x50f, 0x406, 0x30a, 0x203, 0x109, 0x000,
+    };
+
+    // Triangles for each case as triples of edges, 16 entries per case ending in -1
+    private static readonly sbyte[] TriangleTable =
+    {
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 9, 1, 3, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 10, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 1, 10, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 2, 0, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        2, 9, 10, 2, 8, 9, 2, 3, 8, -1, -1, -1, -1, -1, -1, -1,
+        2, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 8, 0, 2, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 2, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 9, 1, 11, 8, 1, 2, 11, -1, -1, -1, -1, -1, -1, -1,
+        1, 11, 3, 1, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 8, 0, 10, 11, 0, 1, 10, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 3, 0, 10, 11, 0, 9, 10, -1, -1, -1, -1, -1, -1, -1,
+        8, 10, 11, 8, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        4, 8, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 4, 0, 3, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 4, 8, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 4, 9, 1, 7, 4, 1, 3, 7, -1, -1, -1, -1, -1, -1, -1,
+        1, 10, 2, 4, 8, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 4, 0, 3, 7, 1, 10, 2, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 2, 0, 9, 10, 4, 8, 7, -1, -1, -1, -1, -1, -1, -1,
+        2, 9, 10, 2, 4, 9, 2, 7, 4, 2, 3, 7, -1, -1, -1, -1,
+        2, 11, 3, 4, 8, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 4, 0, 11, 7, 0, 2, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 2, 11, 3, 4, 8, 7, -1, -1, -1, -1, -1, -1, -1,
+        1, 4, 9, 1, 7, 4, 1, 11, 7, 1, 2, 11, -1, -1, -1, -1,
+        1, 11, 3, 1, 10, 11, 4, 8, 7, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 4, 0, 11, 7, 0, 10, 11, 0, 1, 10, -1, -1, -1, -1,
+        0, 11, 3, 0, 10, 11, 0, 9, 10, 4, 8, 7, -1, -1, -1, -1,
+        4, 11, 7, 4, 10, 11, 4, 9, 10, -1, -1, -1, -1, -1, -1, -1,
+        4, 5, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 4, 5, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 1, 0, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 4, 5, 1, 8, 4, 1, 3, 8, -1, -1, -1, -1, -1, -1, -1,
+        1, 10, 2, 4, 5, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 1, 10, 2, 4, 5, 9, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 2, 0, 5, 10, 0, 4, 5, -1, -1, -1, -1, -1, -1, -1,
+        2, 5, 10, 2, 4, 5, 2, 8, 4, 2, 3, 8, -1, -1, -1, -1,
+        2, 11, 3, 4, 5, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 8, 0, 2, 11, 4, 5, 9, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 1, 0, 4, 5, 2, 11, 3, -1, -1, -1, -1, -1, -1, -1,
+        1, 4, 5, 1, 8, 4, 1, 11, 8, 1, 2, 11, -1, -1, -1, -1,
+        1, 11, 3, 1, 10, 11, 4, 5, 9, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 8, 0, 10, 11, 0, 1, 10, 4, 5, 9, -1, -1, -1, -1,
+        0, 11, 3, 0, 10, 11, 0, 5, 10, 0, 4, 5, -1, -1, -1, -1,
+        4, 11, 8, 4, 10, 11, 4, 5, 10, -1, -1, -1, -1, -1, -1, -1,
+        5, 8, 7, 5, 9, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 9, 0, 7, 5, 0, 3, 7, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 1, 0, 7, 5, 0, 8, 7, -1, -1, -1, -1, -1, -1, -1,
+        1, 7, 5, 1, 3, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 10, 2, 5, 8, 7, 5, 9, 8, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 9, 0, 7, 5, 0, 3, 7, 1, 10, 2, -1, -1, -1, -1,
+        0, 10, 2, 0, 5, 10, 0, 7, 5, 0, 8, 7, -1, -1, -1, -1,
+        2, 5, 10, 2, 7, 5, 2, 3, 7, -1, -1, -1, -1, -1, -1, -1,
+        2, 11, 3, 5, 8, 7, 5, 9, 8, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 9, 0, 7, 5, 0, 11, 7, 0, 2, 11, -1, -1, -1, -1,
+        0, 5, 1, 0, 7, 5, 0, 8, 7, 2, 11, 3, -1, -1, -1, -1,
+        1, 7, 5, 1, 11, 7, 1, 2, 11, -1, -1, -1, -1, -1, -1, -1,
+        1, 11, 3, 1, 10, 11, 5, 8, 7, 5, 9, 8, -1, -1, -1, -1,
+        0, 5, 9, 0, 7, 5, 0, 11, 7, 0, 10, 11, 0, 1, 10, -1,
+        0, 11, 3, 0, 10, 11, 0, 5, 10, 0, 7, 5, 0, 8, 7, -1,
+        5, 11, 7, 5, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        5, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 9, 1, 3, 8, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1,
+        1, 6, 2, 1, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 1, 6, 2, 1, 5, 6, -1, -1, -1, -1, -1, -1, -1,
+        0, 6, 2, 0, 5, 6, 0, 9, 5, -1, -1, -1, -1, -1, -1, -1,
+        2, 5, 6, 2, 9, 5, 2, 8, 9, 2, 3, 8, -1, -1, -1, -1,
+        2, 11, 3, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 8, 0, 2, 11, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 2, 11, 3, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 9, 1, 11, 8, 1, 2, 11, 5, 6, 10, -1, -1, -1, -1,
+        1, 11, 3, 1, 6, 11, 1, 5, 6, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 8, 0, 6, 11, 0, 5, 6, 0, 1, 5, -1, -1, -1, -1,
+        0, 11, 3, 0, 6, 11, 0, 5, 6, 0, 9, 5, -1, -1, -1, -1,
+        5, 8, 9, 5, 11, 8, 5, 6, 11, -1, -1, -1, -1, -1, -1, -1,
+        4, 8, 7, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 4, 0, 3, 7, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 4, 8, 7, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1,
+        1, 4, 9, 1, 7, 4, 1, 3, 7, 5, 6, 10, -1, -1, -1, -1,
+        1, 6, 2, 1, 5, 6, 4, 8, 7, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 4, 0, 3, 7, 1, 6, 2, 1, 5, 6, -1, -1, -1, -1,
+        0, 6, 2, 0, 5, 6, 0, 9, 5, 4, 8, 7, -1, -1, -1, -1,
+        2, 5, 6, 2, 9, 5, 2, 4, 9, 2, 7, 4, 2, 3, 7, -1,
+        2, 11, 3, 4, 8, 7, 5, 6, 10, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 4, 0, 11, 7, 0, 2, 11, 5, 6, 10, -1, -1, -1, -1,
+        0, 9, 1, 2, 11, 3, 4, 8, 7, 5, 6, 10, -1, -1, -1, -1,
+        1, 4, 9, 1, 7, 4, 1, 11, 7, 1, 2, 11, 5, 6, 10, -1,
+        1, 11, 3, 1, 6, 11, 1, 5, 6, 4, 8, 7, -1, -1, -1, -1,
+        0, 7, 4, 0, 11, 7, 0, 6, 11, 0, 5, 6, 0, 1, 5, -1,
+        0, 11, 3, 0, 6, 11, 0, 5, 6, 0, 9, 5, 4, 8, 7, -1,
+        11, 5, 6, 11, 9, 5, 11, 4, 9, 11, 7, 4, -1, -1, -1, -1,
+        4, 10, 9, 4, 6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 4, 10, 9, 4, 6, 10, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 1, 0, 6, 10, 0, 4, 6, -1, -1, -1, -1, -1, -1, -1,
+        1, 6, 10, 1, 4, 6, 1, 8, 4, 1, 3, 8, -1, -1, -1, -1,
+        1, 6, 2, 1, 4, 6, 1, 9, 4, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 1, 6, 2, 1, 4, 6, 1, 9, 4, -1, -1, -1, -1,
+        0, 6, 2, 0, 4, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        2, 4, 6, 2, 8, 4, 2, 3, 8, -1, -1, -1, -1, -1, -1, -1,
+        2, 11, 3, 4, 10, 9, 4, 6, 10, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 8, 0, 2, 11, 4, 10, 9, 4, 6, 10, -1, -1, -1, -1,
+        0, 10, 1, 0, 6, 10, 0, 4, 6, 2, 11, 3, -1, -1, -1, -1,
+        1, 6, 10, 1, 4, 6, 1, 8, 4, 1, 11, 8, 1, 2, 11, -1,
+        1, 11, 3, 1, 6, 11, 1, 4, 6, 1, 9, 4, -1, -1, -1, -1,
+        11, 4, 6, 11, 9, 4, 11, 1, 9, 11, 0, 1, 11, 8, 0, -1,
+        0, 11, 3, 0, 6, 11, 0, 4, 6, -1, -1, -1, -1, -1, -1, -1,
+        4, 11, 8, 4, 6, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        6, 8, 7, 6, 9, 8, 6, 10, 9, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 9, 0, 6, 10, 0, 7, 6, 0, 3, 7, -1, -1, -1, -1,
+        0, 10, 1, 0, 6, 10, 0, 7, 6, 0, 8, 7, -1, -1, -1, -1,
+        1, 6, 10, 1, 7, 6, 1, 3, 7, -1, -1, -1, -1, -1, -1, -1,
+        1, 6, 2, 1, 7, 6, 1, 8, 7, 1, 9, 8, -1, -1, -1, -1,
+        9, 2, 1, 9, 6, 2, 9, 7, 6, 9, 3, 7, 9, 0, 3, -1,
+        0, 6, 2, 0, 7, 6, 0, 8, 7, -1, -1, -1, -1, -1, -1, -1,
+        2, 7, 6, 2, 3, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        2, 11, 3, 6, 8, 7, 6, 9, 8, 6, 10, 9, -1, -1, -1, -1,
+        0, 10, 9, 0, 6, 10, 0, 7, 6, 0, 11, 7, 0, 2, 11, -1,
+        0, 10, 1, 0, 6, 10, 0, 7, 6, 0, 8, 7, 2, 11, 3, -1,
+        1, 6, 10, 1, 7, 6, 1, 11, 7, 1, 2, 11, -1, -1, -1, -1,
+        1, 11, 3, 1, 6, 11, 1, 7, 6, 1, 8, 7, 1, 9, 8, -1,
+        0, 1, 9, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 11, 3, 0, 6, 11, 0, 7, 6, 0, 8, 7, -1, -1, -1, -1,
+        6, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        6, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 9, 1, 3, 8, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        1, 10, 2, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 1, 10, 2, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 2, 0, 9, 10, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        2, 9, 10, 2, 8, 9, 2, 3, 8, 6, 7, 11, -1, -1, -1, -1,
+        2, 7, 3, 2, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 8, 0, 6, 7, 0, 2, 6, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 2, 7, 3, 2, 6, 7, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 9, 1, 7, 8, 1, 6, 7, 1, 2, 6, -1, -1, -1, -1,
+        1, 7, 3, 1, 6, 7, 1, 10, 6, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 8, 0, 6, 7, 0, 10, 6, 0, 1, 10, -1, -1, -1, -1,
+        0, 7, 3, 0, 6, 7, 0, 10, 6, 0, 9, 10, -1, -1, -1, -1,
+        6, 9, 10, 6, 8, 9, 6, 7, 8, -1, -1, -1, -1, -1, -1, -1,
+        4, 11, 6, 4, 8, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 6, 4, 0, 11, 6, 0, 3, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 4, 11, 6, 4, 8, 11, -1, -1, -1, -1, -1, -1, -1,
+        1, 4, 9, 1, 6, 4, 1, 11, 6, 1, 3, 11, -1, -1, -1, -1,
+        1, 10, 2, 4, 11, 6, 4, 8, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 6, 4, 0, 11, 6, 0, 3, 11, 1, 10, 2, -1, -1, -1, -1,
+        0, 10, 2, 0, 9, 10, 4, 11, 6, 4, 8, 11, -1, -1, -1, -1,
+        9, 6, 4, 9, 11, 6, 9, 3, 11, 9, 2, 3, 9, 10, 2, -1,
+        2, 8, 3, 2, 4, 8, 2, 6, 4, -1, -1, -1, -1, -1, -1, -1,
+        0, 6, 4, 0, 2, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 2, 8, 3, 2, 4, 8, 2, 6, 4, -1, -1, -1, -1,
+        1, 4, 9, 1, 6, 4, 1, 2, 6, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 3, 1, 4, 8, 1, 6, 4, 1, 10, 6, -1, -1, -1, -1,
+        0, 6, 4, 0, 10, 6, 0, 1, 10, -1, -1, -1, -1, -1, -1, -1,
+        3, 4, 8, 3, 6, 4, 3, 10, 6, 3, 9, 10, 3, 0, 9, -1,
+        4, 10, 6, 4, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        4, 5, 9, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 4, 5, 9, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 1, 0, 4, 5, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        1, 4, 5, 1, 8, 4, 1, 3, 8, 6, 7, 11, -1, -1, -1, -1,
+        1, 10, 2, 4, 5, 9, 6, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 1, 10, 2, 4, 5, 9, 6, 7, 11, -1, -1, -1, -1,
+        0, 10, 2, 0, 5, 10, 0, 4, 5, 6, 7, 11, -1, -1, -1, -1,
+        2, 5, 10, 2, 4, 5, 2, 8, 4, 2, 3, 8, 6, 7, 11, -1,
+        2, 7, 3, 2, 6, 7, 4, 5, 9, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 8, 0, 6, 7, 0, 2, 6, 4, 5, 9, -1, -1, -1, -1,
+        0, 5, 1, 0, 4, 5, 2, 7, 3, 2, 6, 7, -1, -1, -1, -1,
+        1, 4, 5, 1, 8, 4, 1, 7, 8, 1, 6, 7, 1, 2, 6, -1,
+        1, 7, 3, 1, 6, 7, 1, 10, 6, 4, 5, 9, -1, -1, -1, -1,
+        0, 7, 8, 0, 6, 7, 0, 10, 6, 0, 1, 10, 4, 5, 9, -1,
+        0, 7, 3, 0, 6, 7, 0, 10, 6, 0, 5, 10, 0, 4, 5, -1,
+        8, 6, 7, 8, 10, 6, 8, 5, 10, 8, 4, 5, -1, -1, -1, -1,
+        5, 11, 6, 5, 8, 11, 5, 9, 8, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 9, 0, 6, 5, 0, 11, 6, 0, 3, 11, -1, -1, -1, -1,
+        0, 5, 1, 0, 6, 5, 0, 11, 6, 0, 8, 11, -1, -1, -1, -1,
+        1, 6, 5, 1, 11, 6, 1, 3, 11, -1, -1, -1, -1, -1, -1, -1,
+        1, 10, 2, 5, 11, 6, 5, 8, 11, 5, 9, 8, -1, -1, -1, -1,
+        0, 5, 9, 0, 6, 5, 0, 11, 6, 0, 3, 11, 1, 10, 2, -1,
+        0, 10, 2, 0, 5, 10, 0, 6, 5, 0, 11, 6, 0, 8, 11, -1,
+        5, 11, 6, 5, 3, 11, 5, 2, 3, 5, 10, 2, -1, -1, -1, -1,
+        2, 8, 3, 2, 9, 8, 2, 5, 9, 2, 6, 5, -1, -1, -1, -1,
+        0, 5, 9, 0, 6, 5, 0, 2, 6, -1, -1, -1, -1, -1, -1, -1,
+        5, 2, 6, 5, 3, 2, 5, 8, 3, 5, 0, 8, 5, 1, 0, -1,
+        1, 6, 5, 1, 2, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        3, 9, 8, 3, 5, 9, 3, 6, 5, 3, 10, 6, 3, 1, 10, -1,
+        0, 5, 9, 0, 6, 5, 0, 10, 6, 0, 1, 10, -1, -1, -1, -1,
+        0, 8, 3, 5, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        5, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        5, 11, 10, 5, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 5, 11, 10, 5, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 5, 11, 10, 5, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 9, 1, 3, 8, 5, 11, 10, 5, 7, 11, -1, -1, -1, -1,
+        1, 11, 2, 1, 7, 11, 1, 5, 7, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 1, 11, 2, 1, 7, 11, 1, 5, 7, -1, -1, -1, -1,
+        0, 11, 2, 0, 7, 11, 0, 5, 7, 0, 9, 5, -1, -1, -1, -1,
+        2, 7, 11, 2, 5, 7, 2, 9, 5, 2, 8, 9, 2, 3, 8, -1,
+        2, 7, 3, 2, 5, 7, 2, 10, 5, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 8, 0, 5, 7, 0, 10, 5, 0, 2, 10, -1, -1, -1, -1,
+        0, 9, 1, 2, 7, 3, 2, 5, 7, 2, 10, 5, -1, -1, -1, -1,
+        8, 5, 7, 8, 10, 5, 8, 2, 10, 8, 1, 2, 8, 9, 1, -1,
+        1, 7, 3, 1, 5, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 8, 0, 5, 7, 0, 1, 5, -1, -1, -1, -1, -1, -1, -1,
+        0, 7, 3, 0, 5, 7, 0, 9, 5, -1, -1, -1, -1, -1, -1, -1,
+        5, 8, 9, 5, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        4, 10, 5, 4, 11, 10, 4, 8, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 4, 0, 10, 5, 0, 11, 10, 0, 3, 11, -1, -1, -1, -1,
+        0, 9, 1, 4, 10, 5, 4, 11, 10, 4, 8, 11, -1, -1, -1, -1,
+        4, 10, 5, 4, 11, 10, 4, 3, 11, 4, 1, 3, 4, 9, 1, -1,
+        1, 11, 2, 1, 8, 11, 1, 4, 8, 1, 5, 4, -1, -1, -1, -1,
+        4, 1, 5, 4, 2, 1, 4, 11, 2, 4, 3, 11, 4, 0, 3, -1,
+        2, 8, 11, 2, 4, 8, 2, 5, 4, 2, 9, 5, 2, 0, 9, -1,
+        2, 3, 11, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        2, 8, 3, 2, 4, 8, 2, 5, 4, 2, 10, 5, -1, -1, -1, -1,
+        0, 5, 4, 0, 10, 5, 0, 2, 10, -1, -1, -1, -1, -1, -1, -1,
+        0, 9, 1, 2, 8, 3, 2, 4, 8, 2, 5, 4, 2, 10, 5, -1,
+        4, 10, 5, 4, 2, 10, 4, 1, 2, 4, 9, 1, -1, -1, -1, -1,
+        1, 8, 3, 1, 4, 8, 1, 5, 4, -1, -1, -1, -1, -1, -1, -1,
+        0, 5, 4, 0, 1, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        3, 4, 8, 3, 5, 4, 3, 9, 5, 3, 0, 9, -1, -1, -1, -1,
+        4, 9, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        4, 10, 9, 4, 11, 10, 4, 7, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 3, 8, 4, 10, 9, 4, 11, 10, 4, 7, 11, -1, -1, -1, -1,
+        0, 10, 1, 0, 11, 10, 0, 7, 11, 0, 4, 7, -1, -1, -1, -1,
+        1, 11, 10, 1, 7, 11, 1, 4, 7, 1, 8, 4, 1, 3, 8, -1,
+        1, 11, 2, 1, 7, 11, 1, 4, 7, 1, 9, 4, -1, -1, -1, -1,
+        0, 3, 8, 1, 11, 2, 1, 7, 11, 1, 4, 7, 1, 9, 4, -1,
+        0, 11, 2, 0, 7, 11, 0, 4, 7, -1, -1, -1, -1, -1, -1, -1,
+        2, 7, 11, 2, 4, 7, 2, 8, 4, 2, 3, 8, -1, -1, -1, -1,
+        2, 7, 3, 2, 4, 7, 2, 9, 4, 2, 10, 9, -1, -1, -1, -1,
+        7, 9, 4, 7, 10, 9, 7, 2, 10, 7, 0, 2, 7, 8, 0, -1,
+        10, 3, 2, 10, 7, 3, 10, 4, 7, 10, 0, 4, 10, 1, 0, -1,
+        1, 2, 10, 4, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 7, 3, 1, 4, 7, 1, 9, 4, -1, -1, -1, -1, -1, -1, -1,
+        7, 9, 4, 7, 1, 9, 7, 0, 1, 7, 8, 0, -1, -1, -1, -1,
+        0, 7, 3, 0, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        4, 7, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        8, 10, 9, 8, 11, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 9, 0, 11, 10, 0, 3, 11, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 1, 0, 11, 10, 0, 8, 11, -1, -1, -1, -1, -1, -1, -1,
+        1, 11, 10, 1, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 11, 2, 1, 8, 11, 1, 9, 8, -1, -1, -1, -1, -1, -1, -1,
+        9, 2, 1, 9, 11, 2, 9, 3, 11, 9, 0, 3, -1, -1, -1, -1,
+        0, 11, 2, 0, 8, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        2, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        2, 8, 3, 2, 9, 8, 2, 10, 9, -1, -1, -1, -1, -1, -1, -1,
+        0, 10, 9, 0, 2, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        10, 3, 2, 10, 8, 3, 10, 0, 8, 10, 1, 0, -1, -1, -1, -1,
+        1, 2, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 8, 3, 1, 9, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 1, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 8, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    };
+}
@@ -1,7 +1,12 @@
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Threading;
 using System.Threading.Tasks;
 
 namespace SDF;
@@ -14,8 +19,86 @@ public class MeshGenerator
     public int Workers { get; set; } = Environment.ProcessorCount;
     public int Samples { get; set; } = 1 << 22; // 2^22
     public int BatchSize { get; set; } = 32;
+
+    /// <summary>
+    /// Skip batches that provably hold no surface, and sample the others coarse
+    /// to fine, evaluating only the samples near the surface
+    /// </summary>
     public bool Sparse { get; set; } = true;
+
     public bool Verbose { get; set; } = true;
+    public MeshPrecision Precision { get; set; } = MeshPrecision.Double;
+
+    /// <summary>
+    /// Surface extraction algorithm. Dual contouring batches overlap their
+    /// neighbors by two sample planes instead of one, so every edge has its four
+    /// cells in one batch.
+    /// </summary>
+    public MeshMethod Method { get; set; } = MeshMethod.MarchingCubes;
+
+    /// <summary>
+    /// Largest distance <see cref="MeshMethod.AdaptiveDualContouring"/> lets a
+    /// merged leaf's vertex stray from the surface and the tangent planes it
+    /// replaces; a tenth of the step when not set
+    /// </summary>
+    public double? Tolerance { get; set; }
+
+    /// <summary>
+    /// Octree levels used to tighten interval bounds when deciding whether to skip a batch
+    /// </summary>
+    public int IntervalDepth { get; set; } = 3;
+
+    /// <summary>
+    /// Batches are split into octree cells, each with its own pruned tree, while
+    /// the tree has more nodes than this
+    /// </summary>
+    public int PruneLeafNodes { get; set; } = 16;
+
+    /// <summary>
+    /// Smallest cell edge, in samples, that pruning splits a batch down to
+    /// </summary>
+    public int MinPruneCell { get; set; } = 8;
+
+    /// <summary>
+    /// When set, every node evaluation during <see cref="Generate"/> is recorded,
+    /// and the report is printed at the end in verbose mode. The tree is then
+    /// interpreted rather than compiled.
+    /// </summary>
+    public Profiler? Profiler { get; set; }
+
+    /// <summary>
+    /// When set, batches whose pruned tree and sample lattice were meshed before
+    /// are read back from this cache instead of being sampled again
+    /// </summary>
+    public BatchCache? Cache { get; set; }
+
+    /// <summary>
+    /// Before generating, run short calibration passes over a coarsened grid
+    /// and pick <see cref="BatchSize"/>, <see cref="Workers"/> and
+    /// <see cref="Sparse"/> to minimize the projected time of the full run.
+    /// Calibration costs a fixed amount of work, so it pays off on long runs,
+    /// or with a <see cref="TuningFile"/> that spares later runs from it.
+    /// </summary>
+    public bool AutoTune { get; set; }
+
+    /// <summary>
+    /// Fraction of the batches timed for each candidate setting while tuning
+    /// </summary>
+    public double CalibrationFraction { get; set; } = 1.0 / 64;
+
+    /// <summary>
+    /// Batches the grid is coarsened to for each candidate setting while
+    /// tuning; the times measured there are scaled up to the full grid
+    /// </summary>
+    public int CalibrationBatches { get; set; } = 512;
+
+    /// <summary>
+    /// File remembering the tuned settings of each scene, keyed by a hash of the
+    /// tree, step and precision, so later runs skip calibration
+    /// </summary>
+    public string? TuningFile { get; set; }
+
+    private long _samples;
 
     /// <summary>
     /// Generate a mesh from an SDF
@@ -24,23 +107,65 @@ public class MeshGenerator
         double? step = null, 
         (Vector3, Vector3)? bounds = null)
     {
-        var (min, max) = bounds ?? EstimateBounds(sdf);
-        
-        if (Verbose)
+        var triangles = new List<Vector3>();
+        if (Method == MeshMethod.AdaptiveDualContouring)
         {
-            Console.WriteLine($"Bounds: ({min.X:F2}, {min.Y:F2}, {min.Z:F2}) to ({max.X:F2}, {max.Y:F2}, {max.Z:F2})");
+            var (vertices, indices) = RunAdaptive(sdf, step, bounds);
+            triangles.Capacity = indices.Count;
+            foreach (var index in indices)
+                triangles.Add(vertices[index]);
+            return triangles;
         }
 
-        // Calculate step size if not provided
-        if (!step.HasValue)
+        Run(sdf, step, bounds, _ => (_, mesh) => mesh.AppendTriangles(triangles));
+        return triangles;
+    }
+
+    /// <summary>
+    /// Generate an indexed mesh from an SDF. Vertices on the faces shared by
+    /// batches are welded by their edge of the sample grid, so every vertex is
+    /// stored once.
+    /// </summary>
+    public IndexedMesh GenerateIndexed(SDF3 sdf,
+        double? step = null,
+        (Vector3, Vector3)? bounds = null)
+    {
+        if (Method == MeshMethod.AdaptiveDualContouring)
         {
-            var volume = (max.X - min.X) * (max.Y - min.Y) * (max.Z - min.Z);
-            step = Math.Pow(volume / Samples, 1.0 / 3.0);
+            var (vertices, indices) = RunAdaptive(sdf, step, bounds);
+            var buffer = new float[3 * vertices.Count];
+            for (int i = 0; i < vertices.Count; i++)
+            {
+                buffer[3 * i] = (float)vertices[i].X;
+                buffer[3 * i + 1] = (float)vertices[i].Y;
+                buffer[3 * i + 2] = (float)vertices[i].Z;
+            }
+            return new IndexedMesh(buffer, indices.ConvertAll(i => (uint)i).ToArray());
         }
 
-        if (Verbose)
+        MeshWelder? welder = null;
+        Run(sdf, step, bounds, size =>
         {
-            Console.WriteLine($"Step size: {step:F6}");
+            welder = new MeshWelder(size.x, size.y, size.z, BatchSize, Method);
+            return (batch, mesh) => welder.Add(mesh, (batch.X, batch.Y, batch.Z), (batch.Nx, batch.Ny, batch.Nz));
+        });
+        return welder!.ToMesh();
+    }
+
+    /// <summary>
+    /// Mesh every batch and hand the meshes to the merge returned by
+    /// <paramref name="begin"/> for the grid's size in cells, in grid order
+    /// </summary>
+    private void Run(SDF3 sdf, double? step, (Vector3, Vector3)? bounds,
+        Func<(int x, int y, int z), Action<Batch, BatchMesh>> begin)
+    {
+        var startTime = DateTime.Now;
+
+        (sdf, var min, var max, step) = Prepare(sdf, step, bounds);
+
+        if (AutoTune)
+        {
+            Apply(Calibrate(sdf, min, max, step.Value));
         }
 
         // Calculate grid dimensions
@@ -48,6 +173,19 @@ public class MeshGenerator
         var ny = (int)Math.Ceiling((max.Y - min.Y) / step.Value);
         var nz = (int)Math.Ceiling((max.Z - min.Z) / step.Value);
 
+        // With a cache, snap the grid out to whole batches of a lattice through the
+        // origin, so a region lands in the same batch whatever the bounds are and
+        // editing one part leaves the keys of batches elsewhere unchanged
+        (int x, int y, int z)? origin = null;
+        if (Cache != null)
+        {
+            var (x0, x1) = AnchorAxis(min.X, max.X, step.Value);
+            var (y0, y1) = AnchorAxis(min.Y, max.Y, step.Value);
+            var (z0, z1) = AnchorAxis(min.Z, max.Z, step.Value);
+            origin = (x0, y0, z0);
+            (nx, ny, nz) = (x1 - x0, y1 - y0, z1 - z0);
+        }
+
         if (Verbose)
         {
             Console.WriteLine($"Grid dimensions: {nx} x {ny} x {nz}");
@@ -55,128 +193,695 @@ public class MeshGenerator
         }
 
         // Create batches
-        var batches = CreateBatches(min, max, step.Value, nx, ny, nz);
+        var batches = CreateBatches(min, step.Value, nx, ny, nz, origin);
+        var merge = begin((nx, ny, nz));
         
         if (Verbose)
         {
             Console.WriteLine($"Processing {batches.Count} batches...");
         }
+        var (hits, misses) = (Cache?.Hits ?? 0, Cache?.Misses ?? 0);
+        var samples = Interlocked.Read(ref _samples);
 
-        // Process batches in parallel
-        var allTriangles = new List<Vector3>();
-        var lockObj = new object();
-        
-        Parallel.ForEach(batches, new ParallelOptions { MaxDegreeOfParallelism = Workers }, batch =>
+        // Process batches in parallel. Workers take batches in grid order and the
+        // meshes are merged in that order whenever the next one is done, so the
+        // output is the same in every run and few meshes wait to be merged.
+        var meshes = new BatchMesh?[batches.Count];
+        var finished = new bool[batches.Count];
+        int next = 0;
+        long triangles = 0;
+        var order = Partitioner.Create(Enumerable.Range(0, batches.Count), EnumerablePartitionerOptions.NoBuffering);
+
+        using (Profiler?.Start())
         {
-            var triangles = ProcessBatch(sdf, batch);
-            if (triangles != null && triangles.Count > 0)
+            Parallel.ForEach(order, new ParallelOptions { MaxDegreeOfParallelism = Workers }, i =>
             {
-                lock (lockObj)
+                var mesh = ProcessBatch(sdf, batches[i]);
+                lock (finished)
                 {
-                    allTriangles.AddRange(triangles);
+                    (meshes[i], finished[i]) = (mesh, true);
+                    for (; next < batches.Count && finished[next]; next++)
+                    {
+                        if (meshes[next] is { TriangleCount: > 0 } done)
+                        {
+                            merge(batches[next], done);
+                            triangles += done.TriangleCount;
+                        }
+                        meshes[next] = null;
+                    }
                 }
+            });
+        }
+
+        if (Verbose)
+        {
+            var elapsed = (DateTime.Now - startTime).TotalSeconds;
+            Console.WriteLine($"Generated {triangles} triangles in {elapsed:F2}s");
+            Console.WriteLine($"Evaluated {Interlocked.Read(ref _samples) - samples} samples");
+            if (Cache != null)
+            {
+                Console.WriteLine($"Batch cache: {Cache.Hits - hits} hits, {Cache.Misses - misses} misses");
             }
-        });
+            if (Profiler != null)
+            {
+                Console.Write(Profiler.Report());
+            }
+        }
+    }
+
+    /// <summary>
+    /// Mesh the whole grid with one octree, whose leaves are already shared
+    /// </summary>
+    private (List<Vector3> vertices, List<int> indices) RunAdaptive(SDF3 sdf, double? step, (Vector3, Vector3)? bounds)
+    {
+        var startTime = DateTime.Now;
+        (sdf, var min, var max, var resolved) = Prepare(sdf, step, bounds);
+
+        var nx = (int)Math.Ceiling((max.X - min.X) / resolved);
+        var ny = (int)Math.Ceiling((max.Y - min.Y) / resolved);
+        var nz = (int)Math.Ceiling((max.Z - min.Z) / resolved);
+        if (Verbose)
+        {
+            Console.WriteLine($"Grid dimensions: {nx} x {ny} x {nz}");
+            Console.WriteLine("Generating adaptive mesh...");
+        }
+
+        var mesher = new OctreeMesher(sdf, min, resolved, (nx, ny, nz), Tolerance ?? resolved / 10, Workers);
+        (List<Vector3>, List<int>) mesh;
+        using (Profiler?.Start())
+        {
+            mesh = mesher.Run();
+        }
 
         if (Verbose)
         {
-            Console.WriteLine($"Generated {allTriangles.Count / 3} triangles");
+            var elapsed = (DateTime.Now - startTime).TotalSeconds;
+            Console.WriteLine($"Generated {mesh.Item2.Count / 3} triangles from {mesher.Leaves} leaves and {mesher.Evaluations} evaluations in {elapsed:F2}s");
+            if (Profiler != null)
+            {
+                Console.Write(Profiler.Report());
+            }
         }
+        return mesh;
+    }
 
-        return allTriangles;
+    /// <summary>
+    /// Calibrate <see cref="BatchSize"/>, <see cref="Workers"/> and
+    /// <see cref="Sparse"/> for a scene as <see cref="AutoTune"/> does, apply
+    /// them and return them
+    /// </summary>
+    public MeshTuning Tune(SDF3 sdf, double? step = null, (Vector3, Vector3)? bounds = null)
+    {
+        var (prepared, min, max, resolved) = Prepare(sdf, step, bounds);
+        var tuning = Calibrate(prepared, min, max, resolved);
+        Apply(tuning);
+        return tuning;
     }
 
-    private List<Vector3>? ProcessBatch(SDF3 sdf, Batch batch)
+    /// <summary>
+    /// Fold, share and compile the tree, and settle the bounds and step
+    /// </summary>
+    private (SDF3 sdf, Vector3 min, Vector3 max, double step) Prepare(SDF3 sdf, double? step, (Vector3, Vector3)? bounds)
     {
+        // Fold transform chains and merge repeated subtrees, then fuse the tree
+        // into a single per-point kernel. Trees with static subtrees stay
+        // interpreted so those can be baked, and the rest is compiled as it gets hot.
+        sdf = sdf.FoldTransforms().Share();
+        if (!sdf.HasCustom && !sdf.HasStatic && Profiler == null)
+        {
+            sdf = sdf.Compile();
+        }
+
+        // Static subtrees are baked up front rather than once hot, so no batch
+        // samples them exactly while its neighbors read the grid
+        if (Profiler == null)
+        {
+            TieredEvaluation.Bake(sdf);
+        }
+
+        var estimated = !bounds.HasValue;
+        var (min, max) = bounds ?? EstimateBounds(sdf);
+        
+        if (Verbose)
+        {
+            Console.WriteLine($"Bounds: ({min.X:F2}, {min.Y:F2}, {min.Z:F2}) to ({max.X:F2}, {max.Y:F2}, {max.Z:F2})");
+        }
+
+        // Calculate step size if not provided
+        if (!step.HasValue)
+        {
+            var volume = (max.X - min.X) * (max.Y - min.Y) * (max.Z - min.Z);
+            step = Math.Pow(volume / Samples, 1.0 / 3.0);
+        }
+
+        // Estimated bounds can touch the surface, so leave a layer of samples outside it
+        if (estimated)
+        {
+            var padding = new Vector3(step.Value, step.Value, step.Value);
+            min -= padding;
+            max += padding;
+        }
+
+        if (Verbose)
+        {
+            Console.WriteLine($"Step size: {step:F6}");
+        }
+
+        return (sdf, min, max, step.Value);
+    }
+
+    private void Apply(MeshTuning tuning)
+    {
+        BatchSize = tuning.BatchSize;
+        Workers = tuning.Workers;
+        Sparse = tuning.Sparse;
+    }
+
+    /// <summary>
+    /// Project the time of the full run for every batch size and skip strategy,
+    /// then for the best one at each worker count
+    /// </summary>
+    private MeshTuning Calibrate(SDF3 sdf, Vector3 min, Vector3 max, double step)
+    {
+        var key = TuningFile != null ? MeshTuning.Key(sdf, step, Precision) : null;
+        if (key != null && MeshTuning.Load(TuningFile!, key) is { } saved)
+        {
+            if (Verbose)
+            {
+                Console.WriteLine($"Tuning: {saved} (saved)");
+            }
+            return saved;
+        }
+
+        // The grid coarsened to about CalibrationBatches batches of the current
+        // size, and how many times as many batches the full grid has
+        (List<Batch> batches, double scale) Grid()
+        {
+            double full = 1;
+            foreach (var extent in new[] { max.X - min.X, max.Y - min.Y, max.Z - min.Z })
+                full *= Math.Ceiling(Math.Ceiling(extent / step) / BatchSize);
+            var coarse = step * Math.Max(1, Math.Cbrt(full / CalibrationBatches));
+            var batches = CreateBatches(min, coarse,
+                (int)Math.Ceiling((max.X - min.X) / coarse),
+                (int)Math.Ceiling((max.Y - min.Y) / coarse),
+                (int)Math.Ceiling((max.Z - min.Z) / coarse), null);
+            return (batches, Math.Max(1, full / batches.Count));
+        }
+
+        // Calibration must neither read nor fill the cache
+        var (batchSize, sparse, cache) = (BatchSize, Sparse, Cache);
+        Cache = null;
+        try
+        {
+            MeshTuning? best = null;
+            foreach (var candidate in new[] { 64, 32, 16, 8 })
+            {
+                BatchSize = candidate;
+                var (batches, scale) = Grid();
+
+                // The first batch meshed also compiles the kernel's code, so it is not timed
+                if (best == null)
+                {
+                    var middle = batches[batches.Count / 2];
+                    MeshBatch(sdf, sdf.Prune(BatchBox(middle)), middle);
+                }
+                foreach (var skip in new[] { true, false })
+                {
+                    Sparse = skip;
+                    var (seconds, meshed) = Project(sdf, batches, scale, 1);
+                    if (best == null || seconds < best.ProjectedSeconds)
+                    {
+                        best = new MeshTuning(candidate, 1, skip, seconds);
+                    }
+
+                    // Meshing every batch only pays off when few could be skipped
+                    if (meshed < 0.5)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            // Memory bandwidth and uneven batches keep concurrency from scaling
+            // perfectly, so the worker count is measured too
+            BatchSize = best!.BatchSize;
+            Sparse = best.Sparse;
+            var (grid, gridScale) = Grid();
+            for (int workers = Environment.ProcessorCount; workers > 1; workers /= 2)
+            {
+                var (seconds, _) = Project(sdf, grid, gridScale, workers);
+                if (seconds < best.ProjectedSeconds)
+                {
+                    best = new MeshTuning(best.BatchSize, workers, best.Sparse, seconds);
+                }
+            }
+
+            if (Verbose)
+            {
+                Console.WriteLine($"Tuning: {best}");
+            }
+            if (key != null)
+            {
+                MeshTuning.Save(TuningFile!, key, best);
+            }
+            return best;
+        }
+        finally
+        {
+            (BatchSize, Sparse, Cache) = (batchSize, sparse, cache);
+        }
+    }
+
+    /// <summary>
+    /// Projected time to process every batch of a grid with <paramref name="scale"/>
+    /// times as many batches as <paramref name="batches"/>, with the current
+    /// settings, and the fraction of its batches meshed. With sparse sampling
+    /// the skip test runs on every batch, since surface batches can be too rare
+    /// for a sample to find, and only the batches it keeps are sampled for meshing.
+    /// </summary>
+    private (double seconds, double meshed) Project(SDF3 sdf, List<Batch> batches, double scale, int workers)
+    {
+        var options = new ParallelOptions { MaxDegreeOfParallelism = workers };
+        var timer = Stopwatch.StartNew();
+        var meshed = batches;
+        if (Sparse)
+        {
+            var keep = new bool[batches.Count];
+            Parallel.For(0, batches.Count, options, i => keep[i] = !ShouldSkip(sdf.Prune(BatchBox(batches[i])), batches[i]));
+            meshed = batches.Where((_, i) => keep[i]).ToList();
+        }
+        // Every batch is tested, but only those near the surface are kept, and
+        // the surface crosses scale^(2/3) times as many batches of the full grid
+        var skipping = timer.Elapsed.TotalSeconds * scale;
+        var surface = Sparse ? Math.Pow(scale, 2.0 / 3) : scale;
+
+        // Evenly spaced, and enough to keep every worker busy
+        var count = Math.Max(Math.Max(4, 2 * workers), (int)Math.Ceiling(batches.Count * CalibrationFraction));
+        var sample = count >= meshed.Count
+            ? meshed
+            : Enumerable.Range(0, count).Select(i => meshed[(int)((long)i * meshed.Count / count)]).ToList();
+        var fraction = Math.Min(1, meshed.Count * surface / (batches.Count * scale));
+        if (sample.Count == 0)
+        {
+            return (skipping, fraction);
+        }
+
+        timer.Restart();
+        Parallel.ForEach(sample, options, batch => MeshBatch(sdf, sdf.Prune(BatchBox(batch)), batch));
+        return (skipping + timer.Elapsed.TotalSeconds * meshed.Count / sample.Count * surface, fraction);
+    }
+
+    private BatchMesh? ProcessBatch(SDF3 sdf, Batch batch)
+    {
+        // Drop the union and intersection branches that cannot matter inside this batch
+        var local = sdf.Prune(BatchBox(batch));
+
         // Skip batch if it's far from the surface (for sparse sampling)
-        if (Sparse && ShouldSkip(sdf, batch))
+        if (Sparse && ShouldSkip(local, batch))
         {
             return null;
         }
 
-        // Sample the SDF at all grid points in the batch
-        var points = new List<Vector3>();
-        for (int x = 0; x < batch.Nx; x++)
+        var key = Cache?.Key(local, batch.Min, batch.Step,
+            (batch.Nx, batch.Ny, batch.Nz), Precision, Method);
+        if (key != null && Cache!.TryLoad(key, out var cached))
+        {
+            return cached;
+        }
+
+        var mesh = MeshBatch(sdf, local, batch);
+        if (key != null)
+        {
+            Cache!.Store(key, mesh);
+        }
+        return mesh;
+    }
+
+    private BatchMesh MeshBatch(SDF3 sdf, SDF3 local, Batch batch)
+    {
+        var cells = new List<Cell>();
+        Specialize(sdf, local, batch, new Cell { X1 = batch.Nx - 1, Y1 = batch.Ny - 1, Z1 = batch.Nz - 1 }, cells);
+
+        var step = new Vector3(batch.Step, batch.Step, batch.Step);
+        var offset = batch.Min;
+
+        var mesh = new BatchMesh();
+        // Dual contouring evaluates its crossings in double precision anyway,
+        // so the single-precision modes only differ in how the volume is sampled
+        if (Method == MeshMethod.DualContouring)
         {
-            for (int y = 0; y < batch.Ny; y++)
+            if (Precision == MeshPrecision.Double)
+                DualContouring.Generate(SampleDouble(batch, cells), offset, step, local, BatchSize, mesh);
+            else
+                DualContouring.Generate(SampleSingle(batch, cells), offset, step, local, BatchSize, mesh);
+            return mesh;
+        }
+
+        if (Precision == MeshPrecision.Double)
+        {
+            MarchingCubes.Generate(SampleDouble(batch, cells), offset, step, mesh);
+            return mesh;
+        }
+
+        var volume = SampleSingle(batch, cells);
+        MarchingCubes.Generate(volume, offset, step, mesh);
+        if (Precision == MeshPrecision.SingleRefined)
+        {
+            RefineVertices(local, mesh, volume, step);
+        }
+        return mesh;
+    }
+
+    /// <summary>
+    /// Split a batch into octree cells, pruning the tree again for each one, until
+    /// the cells are small or their trees are. Cost then follows the complexity of
+    /// the scene near each cell rather than the size of the whole tree.
+    /// </summary>
+    private void Specialize(SDF3 root, SDF3 local, Batch batch, Cell cell, List<Cell> cells)
+    {
+        var nodes = CountNodes(local);
+        int sx = cell.X1 - cell.X0 + 1, sy = cell.Y1 - cell.Y0 + 1, sz = cell.Z1 - cell.Z0 + 1;
+        if (nodes > PruneLeafNodes && Math.Min(sx, Math.Min(sy, sz)) >= 2 * MinPruneCell)
+        {
+            int mx = cell.X0 + sx / 2, my = cell.Y0 + sy / 2, mz = cell.Z0 + sz / 2;
+            for (int i = 0; i < 8; i++)
             {
-                for (int z = 0; z < batch.Nz; z++)
+                var child = new Cell
                 {
-                    points.Add(new Vector3(
-                        batch.MinX + x * batch.StepX,
-                        batch.MinY + y * batch.StepY,
-                        batch.MinZ + z * batch.StepZ
-                    ));
-                }
+                    X0 = (i & 1) == 0 ? cell.X0 : mx,
+                    X1 = (i & 1) == 0 ? mx - 1 : cell.X1,
+                    Y0 = (i & 2) == 0 ? cell.Y0 : my,
+                    Y1 = (i & 2) == 0 ? my - 1 : cell.Y1,
+                    Z0 = (i & 4) == 0 ? cell.Z0 : mz,
+                    Z1 = (i & 4) == 0 ? mz - 1 : cell.Z1,
+                };
+                Specialize(root, local.Prune(CellBox(batch, child)), batch, child, cells);
             }
+            return;
         }
 
-        var values = sdf.Evaluate(points.ToArray());
-        
-        // Reshape into 3D array
+        // The fused kernel still beats interpreting a pruned tree unless most of it is gone
+        if (root.Kernel != null && Precision == MeshPrecision.Double && 3 * nodes > CountNodes(root))
+        {
+            local = root;
+        }
+        cell.Sdf = local;
+        cells.Add(cell);
+    }
+
+    private double[,,] SampleDouble(Batch batch, List<Cell> cells)
+    {
         var volume = new double[batch.Nx, batch.Ny, batch.Nz];
-        int idx = 0;
-        for (int x = 0; x < batch.Nx; x++)
+        foreach (var cell in cells)
         {
-            for (int y = 0; y < batch.Ny; y++)
+            if (SampleNarrowBand(volume, batch, cell, samples =>
+                {
+                    var values = cell.Sdf.Evaluate(Points(batch, samples));
+                    var flat = NarrowBand.Flat(volume);
+                    for (int i = 0; i < samples.Length; i++)
+                        flat[samples[i]] = values[i];
+                }))
+            {
+                continue;
+            }
+
+            // Sample the SDF at all grid points in the cell
+            var points = new Vector3[cell.Count];
+            int idx = 0;
+            for (int x = cell.X0; x <= cell.X1; x++)
+            {
+                for (int y = cell.Y0; y <= cell.Y1; y++)
+                {
+                    for (int z = cell.Z0; z <= cell.Z1; z++)
+                    {
+                        points[idx++] = batch.Sample(x, y, z);
+                    }
+                }
+            }
+
+            var values = cell.Sdf.Evaluate(points);
+            Interlocked.Add(ref _samples, points.Length);
+
+            // A cell spanning the whole batch is already in the volume's memory order
+            if (cell.Count == volume.Length)
+            {
+                Buffer.BlockCopy(values, 0, volume, 0, values.Length * sizeof(double));
+                continue;
+            }
+
+            idx = 0;
+            for (int x = cell.X0; x <= cell.X1; x++)
+                for (int y = cell.Y0; y <= cell.Y1; y++)
+                    for (int z = cell.Z0; z <= cell.Z1; z++)
+                        volume[x, y, z] = values[idx++];
+        }
+        return volume;
+    }
+
+    private float[,,] SampleSingle(Batch batch, List<Cell> cells)
+    {
+        var volume = new float[batch.Nx, batch.Ny, batch.Nz];
+        var scratch = EvalScratch.Current;
+        foreach (var cell in cells)
+        {
+            if (SampleNarrowBand(volume, batch, cell, samples =>
+                {
+                    var mark = scratch.Mark;
+                    var xs = scratch.Rent(samples.Length);
+                    var ys = scratch.Rent(samples.Length);
+                    var zs = scratch.Rent(samples.Length);
+                    var values = scratch.Rent(samples.Length);
+                    try
+                    {
+                        var points = Points(batch, samples);
+                        for (int i = 0; i < points.Length; i++)
+                            (xs[i], ys[i], zs[i]) = ((float)points[i].X, (float)points[i].Y, (float)points[i].Z);
+                        cell.Sdf.Evaluate(xs, ys, zs, values, scratch);
+                        var flat = NarrowBand.Flat(volume);
+                        for (int i = 0; i < samples.Length; i++)
+                            flat[samples[i]] = values[i];
+                    }
+                    finally
+                    {
+                        scratch.Release(mark);
+                    }
+                }))
+            {
+                continue;
+            }
+
+            var mark = scratch.Mark;
+            var count = cell.Count;
+            var xs = scratch.Rent(count);
+            var ys = scratch.Rent(count);
+            var zs = scratch.Rent(count);
+
+            int idx = 0;
+            for (int x = cell.X0; x <= cell.X1; x++)
+            {
+                var px = (float)batch.Sample(x, 0, 0).X;
+                for (int y = cell.Y0; y <= cell.Y1; y++)
+                {
+                    var py = (float)batch.Sample(0, y, 0).Y;
+                    for (int z = cell.Z0; z <= cell.Z1; z++)
+                    {
+                        xs[idx] = px;
+                        ys[idx] = py;
+                        zs[idx] = (float)batch.Sample(0, 0, z).Z;
+                        idx++;
+                    }
+                }
+            }
+
+            // Lanes follow the volume's memory order (z fastest), so a cell spanning
+            // the whole batch is evaluated straight into it
+            var whole = count == volume.Length;
+            var values = whole
+                ? MemoryMarshal.CreateSpan(ref Unsafe.As<byte, float>(ref MemoryMarshal.GetArrayDataReference(volume)), count)
+                : scratch.Rent(count);
+            try
             {
-                for (int z = 0; z < batch.Nz; z++)
+                cell.Sdf.Evaluate(xs, ys, zs, values, scratch);
+                Interlocked.Add(ref _samples, count);
+                if (!whole)
                 {
-                    volume[x, y, z] = values[idx++];
+                    idx = 0;
+                    for (int x = cell.X0; x <= cell.X1; x++)
+                        for (int y = cell.Y0; y <= cell.Y1; y++)
+                            for (int z = cell.Z0; z <= cell.Z1; z++)
+                                volume[x, y, z] = values[idx++];
                 }
             }
+            finally
+            {
+                scratch.Release(mark);
+            }
         }
+        return volume;
+    }
+
+    /// <summary>
+    /// With <see cref="Sparse"/>, sample a cell coarse to fine, evaluating only
+    /// near the surface. Trees whose Lipschitz bound is unknown over the cell
+    /// are left to be sampled densely.
+    /// </summary>
+    private bool SampleNarrowBand<T>(T[,,] volume, Batch batch, Cell cell, NarrowBand.Evaluator evaluate)
+        where T : unmanaged, INumberBase<T>
+    {
+        if (!Sparse)
+            return false;
+        var lipschitz = cell.Sdf.LipschitzBound(CellBox(batch, cell));
+        if (!double.IsFinite(lipschitz))
+            return false;
 
-        // Apply marching cubes
-        var step = new Vector3(batch.StepX, batch.StepY, batch.StepZ);
-        var offset = new Vector3(batch.MinX, batch.MinY, batch.MinZ);
-        return MarchingCubes.Generate(volume, offset, step);
+        var samples = NarrowBand.Sample(volume, (cell.X0, cell.Y0, cell.Z0), (cell.X1, cell.Y1, cell.Z1),
+            new Vector3(batch.Step, batch.Step, batch.Step), lipschitz, evaluate);
+        Interlocked.Add(ref _samples, samples);
+        return true;
     }
 
-    private bool ShouldSkip(SDF3 sdf, Batch batch)
+    /// <summary>
+    /// Positions of the samples at the given indices into a batch's volume
+    /// </summary>
+    private static Vector3[] Points(Batch batch, int[] samples)
     {
-        // Check center point and corners
-        var center = new Vector3(
-            (batch.MinX + batch.MaxX) / 2,
-            (batch.MinY + batch.MaxY) / 2,
-            (batch.MinZ + batch.MaxZ) / 2
-        );
+        var points = new Vector3[samples.Length];
+        for (int i = 0; i < samples.Length; i++)
+        {
+            int z = samples[i] % batch.Nz, y = samples[i] / batch.Nz % batch.Ny, x = samples[i] / batch.Nz / batch.Ny;
+            points[i] = batch.Sample(x, y, z);
+        }
+        return points;
+    }
 
-        var r = Math.Abs(sdf.Evaluate(new[] { center })[0]);
-        var dx = batch.MaxX - batch.MinX;
-        var dy = batch.MaxY - batch.MinY;
-        var dz = batch.MaxZ - batch.MinZ;
-        var d = Math.Sqrt(dx * dx + dy * dy + dz * dz) / 2;
+    /// <summary>
+    /// Move every vertex along the lattice edge it was interpolated on, using one
+    /// double-precision evaluation per vertex and a regula falsi step against the
+    /// float samples at the edge end points
+    /// </summary>
+    private static void RefineVertices(SDF3 sdf, BatchMesh mesh, float[,,] volume, Vector3 step)
+    {
+        var vertices = mesh.Vertices;
+        if (vertices.Count == 0)
+            return;
 
-        if (r > d)
+        var values = sdf.Evaluate(vertices.ToArray());
+        int ny = volume.GetLength(1), nz = volume.GetLength(2);
+        for (int i = 0; i < vertices.Count; i++)
         {
-            // Check corners
-            var corners = new[]
+            var edge = mesh.Keys[i];
+            int axis = (int)(edge % 3);
+            var sample = edge / 3;
+            int z = (int)(sample % nz), y = (int)(sample / nz % ny), x = (int)(sample / nz / ny);
+            double v0 = volume[x, y, z];
+            double v1 = axis switch
             {
-                new Vector3(batch.MinX, batch.MinY, batch.MinZ),
-                new Vector3(batch.MaxX, batch.MinY, batch.MinZ),
-                new Vector3(batch.MinX, batch.MaxY, batch.MinZ),
-                new Vector3(batch.MaxX, batch.MaxY, batch.MinZ),
-                new Vector3(batch.MinX, batch.MinY, batch.MaxZ),
-                new Vector3(batch.MaxX, batch.MinY, batch.MaxZ),
-                new Vector3(batch.MinX, batch.MaxY, batch.MaxZ),
-                new Vector3(batch.MaxX, batch.MaxY, batch.MaxZ),
+                0 => volume[x + 1, y, z],
+                1 => volume[x, y + 1, z],
+                _ => volume[x, y, z + 1],
             };
 
-            var cornerValues = sdf.Evaluate(corners);
-            var allPositive = cornerValues.All(v => v > 0);
-            var allNegative = cornerValues.All(v => v < 0);
-            
-            return allPositive || allNegative;
+            // The vertex sits where marching cubes interpolated the two samples
+            var t = v0 / (v0 - v1);
+            var fm = values[i];
+            double refined;
+            if ((fm < 0) == (v0 < 0))
+                refined = t + (1 - t) * fm / (fm - v1);
+            else
+                refined = t * v0 / (v0 - fm);
+            if (double.IsNaN(refined))
+                continue;
+            refined = Math.Clamp(refined, 0.0, 1.0);
+
+            var v = vertices[i];
+            var delta = (refined - t) * (axis == 0 ? step.X : axis == 1 ? step.Y : step.Z);
+            vertices[i] = axis switch
+            {
+                0 => new Vector3(v.X + delta, v.Y, v.Z),
+                1 => new Vector3(v.X, v.Y + delta, v.Z),
+                _ => new Vector3(v.X, v.Y, v.Z + delta),
+            };
         }
+    }
+
+    private bool ShouldSkip(SDF3 sdf, Batch batch)
+    {
+        var box = BatchBox(batch);
 
-        return false;
+        // Interval arithmetic proves a batch empty when its range excludes zero
+        var range = sdf.EvaluateInterval(box);
+        if (range.Lo > 0 || range.Hi < 0)
+        {
+            return true;
+        }
+
+        // Without custom leaves the ranges are trustworthy, so refine them on an
+        // octree instead of guessing from samples
+        if (!sdf.HasCustom)
+        {
+            return !IntervalEvaluator.MayContainSurface(sdf, box, IntervalDepth);
+        }
+
+        // Custom leaves cannot be bounded over a box, but a sample at the center
+        // still rules out any surface closer than |d| / L
+        var center = (batch.Min + batch.Max) / 2;
+
+        var r = Math.Abs(sdf.Evaluate(new[] { center })[0]);
+        var d = (batch.Max - batch.Min).Length() / 2;
+
+        return r > d * sdf.LipschitzBound(box);
+    }
+
+    /// <summary>
+    /// Box around a batch's samples, widened slightly so float rounding of the
+    /// sample coordinates cannot place one outside it
+    /// </summary>
+    private static (Vector3 min, Vector3 max) BatchBox(Batch batch)
+    {
+        var margin = new Vector3(1, 1, 1) * (1e-3 * batch.Step);
+        return (batch.Min - margin, batch.Max + margin);
+    }
+
+    private static (Vector3 min, Vector3 max) CellBox(Batch batch, Cell cell)
+    {
+        var margin = new Vector3(1, 1, 1) * (1e-3 * batch.Step);
+        return (batch.Sample(cell.X0, cell.Y0, cell.Z0) - margin, batch.Sample(cell.X1, cell.Y1, cell.Z1) + margin);
     }
 
-    private List<Batch> CreateBatches(Vector3 min, Vector3 max, double step, int nx, int ny, int nz)
+    private static int CountNodes(SDF3 sdf)
+    {
+        int count = 1;
+        foreach (var child in sdf.Inputs)
+            count += CountNodes(child);
+        return count;
+    }
+
+    /// <summary>
+    /// Sample indices, multiples of the batch size, of a lattice through the
+    /// origin that covers [min, max] along one axis
+    /// </summary>
+    private (int, int) AnchorAxis(double min, double max, double step)
+    {
+        var first = (int)Math.Floor(min / step / BatchSize) * BatchSize;
+        var last = (int)Math.Ceiling(max / step / BatchSize) * BatchSize;
+        return (first, Math.Max(last, first + BatchSize));
+    }
+
+    /// <summary>
+    /// Batches of a grid starting at <paramref name="min"/>, or at sample index
+    /// <paramref name="origin"/> of the lattice through the origin when given
+    /// </summary>
+    private List<Batch> CreateBatches(Vector3 min, double step, int nx, int ny, int nz, (int x, int y, int z)? origin)
     {
         var batches = new List<Batch>();
         var batchSize = BatchSize;
+        var overlap = Method == MeshMethod.DualContouring ? 2 : 1;
+
+        // Samples are placed from their index in the whole grid, so batches sharing a
+        // sample give it bit-identical coordinates. On the lattice through the
+        // origin that index counts from the origin, so a batch at the same place
+        // gets the same coordinates in every run too.
+        var (gridMin, first) = origin is { } o ? (Vector3.Zero, o) : (min, (0, 0, 0));
 
         for (int bx = 0; bx < nx; bx += batchSize)
         {
@@ -186,20 +891,16 @@ public class MeshGenerator
                 {
                     var batch = new Batch
                     {
-                        MinX = (float)(min.X + bx * step),
-                        MinY = (float)(min.Y + by * step),
-                        MinZ = (float)(min.Z + bz * step),
-                        Nx = Math.Min(batchSize + 1, nx - bx + 1),
-                        Ny = Math.Min(batchSize + 1, ny - by + 1),
-                        Nz = Math.Min(batchSize + 1, nz - bz + 1),
-                        StepX = (float)step,
-                        StepY = (float)step,
-                        StepZ = (float)step
+                        X = bx,
+                        Y = by,
+                        Z = bz,
+                        Nx = Math.Min(batchSize + overlap, nx - bx + 1),
+                        Ny = Math.Min(batchSize + overlap, ny - by + 1),
+                        Nz = Math.Min(batchSize + overlap, nz - bz + 1),
+                        GridMin = gridMin,
+                        First = first,
+                        Step = step,
                     };
-                    batch.MaxX = (float)(batch.MinX + (batch.Nx - 1) * step);
-                    batch.MaxY = (float)(batch.MinY + (batch.Ny - 1) * step);
-                    batch.MaxZ = (float)(batch.MinZ + (batch.Nz - 1) * step);
-                    
                     batches.Add(batch);
                 }
             }
@@ -210,6 +911,13 @@ public class MeshGenerator
 
     public (Vector3, Vector3) EstimateBounds(SDF3 sdf)
     {
+        // Exact boxes propagate through the graph; sampling is only needed
+        // when custom leaves or unbounded primitives are left open
+        if (sdf.Bounds is { } exact)
+        {
+            return exact;
+        }
+
         const int samples = 16;
         var min = new Vector3(-1e9f, -1e9f, -1e9f);
         var max = new Vector3(1e9f, 1e9f, 1e9f);
@@ -282,11 +990,37 @@ public class MeshGenerator
         return (min, max);
     }
 
+    /// <summary>
+    /// Inclusive range of sample indices within a batch and the tree pruned for it
+    /// </summary>
+    private class Cell
+    {
+        public int X0, Y0, Z0;
+        public int X1, Y1, Z1;
+        public SDF3 Sdf = null!;
+        public int Count => (X1 - X0 + 1) * (Y1 - Y0 + 1) * (Z1 - Z0 + 1);
+    }
+
     private class Batch
     {
-        public float MinX, MinY, MinZ;
-        public float MaxX, MaxY, MaxZ;
+        // Index of the first sample in the grid
+        public int X, Y, Z;
         public int Nx, Ny, Nz;
-        public float StepX, StepY, StepZ;
+
+        // Sample i of the grid along an axis lies at GridMin + (First + i) * Step
+        public Vector3 GridMin;
+        public (int x, int y, int z) First;
+        public double Step;
+
+        public Vector3 Min => Sample(0, 0, 0);
+        public Vector3 Max => Sample(Nx - 1, Ny - 1, Nz - 1);
+
+        /// <summary>
+        /// Position of the batch's sample (x, y, z), the same in every batch holding it
+        /// </summary>
+        public Vector3 Sample(int x, int y, int z) => new(
+            GridMin.X + (First.x + X + x) * Step,
+            GridMin.Y + (First.y + Y + y) * Step,
+            GridMin.Z + (First.z + Z + z) * Step);
     }
 }
@@ -0,0 +1,30 @@
+namespace SDF;
+
+/// <summary>
+/// Surface extraction algorithm used to mesh the sampled volume
+/// </summary>
+public enum MeshMethod
+{
+    /// <summary>
+    /// Table-driven marching cubes: vertices on the lattice edges, so sharp
+    /// edges and corners are cut off unless the step is fine
+    /// </summary>
+    MarchingCubes,
+
+    /// <summary>
+    /// Dual contouring: one vertex per cell placed by a QEF fit to the edge
+    /// crossings and the surface normals there, which keeps sharp edges and
+    /// corners on much coarser grids
+    /// </summary>
+    DualContouring,
+
+    /// <summary>
+    /// Dual contouring on an octree that refines only where the surface is and
+    /// curves away from its tangent planes by more than
+    /// <see cref="MeshGenerator.Tolerance"/>, down to the step. Leaves of
+    /// different sizes are joined without cracks. Always samples in double
+    /// precision, and does not use batches, so the batch size, batch cache and
+    /// tuning do not apply.
+    /// </summary>
+    AdaptiveDualContouring,
+}
@@ -0,0 +1,19 @@
+namespace SDF;
+
+/// <summary>
+/// Numeric precision used while sampling and meshing an SDF
+/// </summary>
+public enum MeshPrecision
+{
+    /// <summary>Evaluate, store and march the volume in double precision</summary>
+    Double,
+
+    /// <summary>Evaluate with SIMD float kernels and keep the volume in float32</summary>
+    Single,
+
+    /// <summary>
+    /// Like <see cref="Single"/>, then re-evaluate each vertex once in double
+    /// precision and move it along its lattice edge with a regula falsi step
+    /// </summary>
+    SingleRefined,
+}
@@ -0,0 +1,85 @@
+using System;
+using System.Buffers.Binary;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using System.Security.Cryptography;
+
+namespace SDF;
+
+/// <summary>
+/// Batch size, worker count and skip strategy picked by
+/// <see cref="MeshGenerator.Tune"/>, with the projected time of the full run
+/// </summary>
+public sealed class MeshTuning
+{
+    public MeshTuning(int batchSize, int workers, bool sparse, double projectedSeconds)
+    {
+        BatchSize = batchSize;
+        Workers = workers;
+        Sparse = sparse;
+        ProjectedSeconds = projectedSeconds;
+    }
+
+    public int BatchSize { get; }
+    public int Workers { get; }
+    public bool Sparse { get; }
+    public double ProjectedSeconds { get; }
+
+    public override string ToString() =>
+        $"batch size {BatchSize}, {Workers} workers, sparse {Sparse}, projected {ProjectedSeconds:F2}s";
+
+    /// <summary>
+    /// Key of a scene in a tuning file, or null when the tree has custom leaves.
+    /// The processor count is part of it, since the best settings depend on the machine.
+    /// </summary>
+    internal static string? Key(SDF3 sdf, double step, MeshPrecision precision)
+    {
+        if (sdf.ContentHash is not { } content)
+            return null;
+
+        var buffer = new byte[content.Length + 16];
+        content.CopyTo(buffer, 0);
+        BinaryPrimitives.WriteDoubleLittleEndian(buffer.AsSpan(content.Length), step);
+        BinaryPrimitives.WriteInt32LittleEndian(buffer.AsSpan(content.Length + 8), (int)precision);
+        BinaryPrimitives.WriteInt32LittleEndian(buffer.AsSpan(content.Length + 12), Environment.ProcessorCount);
+        return Convert.ToHexString(SHA256.HashData(buffer)).ToLowerInvariant();
+    }
+
+    // One scene per line: key, batch size, workers, sparse and projected seconds, tab separated
+    internal static MeshTuning? Load(string path, string key)
+    {
+        if (!File.Exists(path))
+            return null;
+        foreach (var line in File.ReadLines(path))
+        {
+            var fields = line.Split('\t');
+            if (fields.Length == 5 && fields[0] == key
+                && int.TryParse(fields[1], NumberStyles.Integer, CultureInfo.InvariantCulture, out var batchSize)
+                && int.TryParse(fields[2], NumberStyles.Integer, CultureInfo.InvariantCulture, out var workers)
+                && bool.TryParse(fields[3], out var sparse)
+                && double.TryParse(fields[4], NumberStyles.Float, CultureInfo.InvariantCulture, out var seconds))
+            {
+                return new MeshTuning(batchSize, workers, sparse, seconds);
+            }
+        }
+        return null;
+    }
+
+    internal static void Save(string path, string key, MeshTuning tuning)
+    {
+        var lines = File.Exists(path)
+            ? File.ReadLines(path).Where(line => !line.StartsWith(key + "\t", StringComparison.Ordinal)).ToList()
+            : new();
+        lines.Add(string.Join('\t', key,
+            tuning.BatchSize.ToString(CultureInfo.InvariantCulture),
+            tuning.Workers.ToString(CultureInfo.InvariantCulture),
+            tuning.Sparse.ToString(),
+            tuning.ProjectedSeconds.ToString("R", CultureInfo.InvariantCulture)));
+
+        // Write beside the file and move it into place, so readers never see half a file
+        var temp = $"{path}.{Guid.NewGuid():N}.tmp";
+        File.WriteAllLines(temp, lines);
+        File.Move(temp, path, overwrite: true);
+    }
+}
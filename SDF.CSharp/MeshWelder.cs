@@ -0,0 +1,102 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace SDF;
+
+/// <summary>
+/// Merges batch meshes into one indexed mesh. Batches start every batch size
+/// samples and overlap their neighbors, so a vertex there is meshed by every
+/// batch around it from the same lattice edge, or the same cell with dual
+/// contouring; its index in the whole grid identifies it, and the copies after
+/// the first map to the first one. An entry is dropped once every batch sharing
+/// it has been merged, so only the open faces between merged and pending
+/// batches are held at any time.
+/// </summary>
+internal sealed class MeshWelder
+{
+    // Bits per axis of a grid edge id, beside the two of the edge axis
+    private const int AxisBits = 20;
+
+    private readonly int _nx, _ny, _nz, _batchSize;
+    private readonly bool _cells;
+    private readonly List<float> _vertices = new();
+    private readonly List<uint> _indices = new();
+    private readonly Dictionary<long, (uint index, int pending)> _shared = new();
+    private uint[] _map = Array.Empty<uint>();
+
+    /// <summary>
+    /// Welder for a grid of <paramref name="nx"/> x <paramref name="ny"/> x
+    /// <paramref name="nz"/> cells split into batches of
+    /// <paramref name="batchSize"/> cells, meshed by <paramref name="method"/>
+    /// </summary>
+    public MeshWelder(int nx, int ny, int nz, int batchSize, MeshMethod method)
+    {
+        if (Math.Max(nx, Math.Max(ny, nz)) >= 1 << AxisBits)
+            throw new ArgumentOutOfRangeException(nameof(nx), $"Indexed meshes support at most {(1 << AxisBits) - 1} cells per axis");
+        (_nx, _ny, _nz) = (nx, ny, nz);
+        _batchSize = batchSize;
+        _cells = method == MeshMethod.DualContouring;
+    }
+
+    public int TriangleCount => _indices.Count / 3;
+
+    /// <summary>
+    /// Merge the mesh of the batch whose first sample is <paramref name="first"/>
+    /// in the grid and which has <paramref name="size"/> samples per axis
+    /// </summary>
+    public void Add(BatchMesh mesh, (int x, int y, int z) first, (int x, int y, int z) size)
+    {
+        if (_map.Length < mesh.Vertices.Count)
+            _map = new uint[mesh.Vertices.Count];
+
+        for (int i = 0; i < mesh.Vertices.Count; i++)
+        {
+            var key = mesh.Keys[i];
+            int axis = _cells ? 3 : (int)(key % 3);
+            var sample = _cells ? key : key / 3;
+            int x = first.x + (int)(sample / size.z / size.y);
+            int y = first.y + (int)(sample / size.z % size.y);
+            int z = first.z + (int)(sample % size.z);
+
+            // An edge only lies in the planes across its axis, while a cell is
+            // in the layer of each axis it starts at
+            int sharing = Sharing(axis != 0, x, _nx) * Sharing(axis != 1, y, _ny) * Sharing(axis != 2, z, _nz);
+            if (sharing == 1)
+            {
+                _map[i] = Append(mesh.Vertices[i]);
+                continue;
+            }
+
+            // Cells take the fourth value of the axis bits
+            var id = (long)x << (2 + 2 * AxisBits) | (long)y << (2 + AxisBits) | (long)z << 2 | (long)axis;
+            ref var entry = ref CollectionsMarshal.GetValueRefOrAddDefault(_shared, id, out var exists);
+            if (!exists)
+                entry = (Append(mesh.Vertices[i]), sharing - 1);
+            _map[i] = entry.index;
+            if (exists && --entry.pending == 0)
+                _shared.Remove(id);
+        }
+
+        foreach (var index in mesh.Indices)
+            _indices.Add(_map[index]);
+    }
+
+    /// <summary>
+    /// Batches meshing what lies at <paramref name="index"/> along one axis: two
+    /// where one batch ends and the next starts, one elsewhere
+    /// </summary>
+    private int Sharing(bool shared, int index, int cells) =>
+        shared && index > 0 && index < cells && index % _batchSize == 0 ? 2 : 1;
+
+    private uint Append(Vector3 vertex)
+    {
+        var index = (uint)(_vertices.Count / 3);
+        _vertices.Add((float)vertex.X);
+        _vertices.Add((float)vertex.Y);
+        _vertices.Add((float)vertex.Z);
+        return index;
+    }
+
+    public IndexedMesh ToMesh() => new(_vertices.ToArray(), _indices.ToArray());
+}
@@ -0,0 +1,178 @@
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace SDF;
+
+/// <summary>
+/// Coarse-to-fine sampling of a box of a volume. The box is split in half
+/// along each axis, level by level, and only the blocks the surface may come
+/// near are split further, down to single cells. A block is settled when one
+/// of its corners is farther from the surface than L times its diagonal plus a
+/// step: then no sample in it is within a step of the surface, so no lattice
+/// edge touching it is crossed, and its samples only need the right sign:
+/// they all take the value of its first corner. Samples are evaluated where
+/// the surface is rather than everywhere, so their number grows with the area
+/// of the surface rather than the volume of the box.
+/// </summary>
+internal static class NarrowBand
+{
+    /// <summary>
+    /// Evaluate the samples at the given indices into the volume, in its memory order
+    /// </summary>
+    public delegate void Evaluator(int[] samples);
+
+    /// <summary>
+    /// Sample the box of samples <paramref name="lo"/> to <paramref name="hi"/>,
+    /// inclusive, of <paramref name="volume"/>, whose lattice has spacing
+    /// <paramref name="step"/>, for a field changing by at most
+    /// <paramref name="lipschitz"/> per unit of distance there. Returns the
+    /// number of samples evaluated.
+    /// </summary>
+    public static int Sample<T>(T[,,] volume, (int x, int y, int z) lo, (int x, int y, int z) hi, Vector3 step,
+        double lipschitz, Evaluator evaluate)
+        where T : unmanaged, INumberBase<T>
+    {
+        var values = Flat(volume);
+        int strideX = volume.GetLength(1) * volume.GetLength(2), strideY = volume.GetLength(2);
+        var margin = lipschitz * Math.Max(step.X, Math.Max(step.Y, step.Z));
+
+        // Samples of the box evaluated or queued, indexed relative to the box
+        int sy = hi.y - lo.y + 1, sz = hi.z - lo.z + 1;
+        var known = new bool[(hi.x - lo.x + 1) * sy * sz];
+        var pending = new List<int>();
+        int evaluated = 0;
+
+        int[] xs = new int[3], ys = new int[3], zs = new int[3];
+        var level = new List<Block> { new(lo.x, lo.y, lo.z, hi.x, hi.y, hi.z) };
+        (xs[0], xs[1], ys[0], ys[1], zs[0], zs[1]) = (lo.x, hi.x, lo.y, hi.y, lo.z, hi.z);
+        Queue(2, 2, 2);
+        Flush();
+
+        var settled = new List<Block>();
+        while (level.Count > 0)
+        {
+            var next = new List<Block>();
+            foreach (var block in level)
+            {
+                int dx = block.X1 - block.X0, dy = block.Y1 - block.Y0, dz = block.Z1 - block.Z0;
+                var diagonal = Math.Sqrt(dx * dx * step.X * step.X + dy * dy * step.Y * step.Y + dz * dz * step.Z * step.Z);
+                int first = block.X0 * strideX + block.Y0 * strideY + block.Z0;
+                if (Farthest(values, first, dx * strideX, dy * strideY, dz) > lipschitz * diagonal + margin)
+                {
+                    settled.Add(block);
+                    continue;
+                }
+
+                // Split in half along the axes more than a cell wide, sampling the
+                // children's corners; children a cell wide are then fully sampled
+                int cx = Split(block.X0, block.X1, xs), cy = Split(block.Y0, block.Y1, ys), cz = Split(block.Z0, block.Z1, zs);
+                Queue(cx, cy, cz);
+                for (int i = 0; i < cx - 1; i++)
+                {
+                    for (int j = 0; j < cy - 1; j++)
+                    {
+                        for (int k = 0; k < cz - 1; k++)
+                        {
+                            if (xs[i + 1] - xs[i] > 1 || ys[j + 1] - ys[j] > 1 || zs[k + 1] - zs[k] > 1)
+                                next.Add(new Block(xs[i], ys[j], zs[k], xs[i + 1], ys[j + 1], zs[k + 1]));
+                        }
+                    }
+                }
+            }
+            Flush();
+            level = next;
+        }
+
+        // Every sample left is inside a settled block. Samples already evaluated
+        // there may be overwritten too, as none of them is an end of a crossed edge.
+        foreach (var block in settled)
+        {
+            var value = values[block.X0 * strideX + block.Y0 * strideY + block.Z0];
+            for (int x = block.X0; x <= block.X1; x++)
+            {
+                for (int y = block.Y0; y <= block.Y1; y++)
+                {
+                    int row = x * strideX + y * strideY;
+                    for (int z = block.Z0; z <= block.Z1; z++)
+                        values[row + z] = value;
+                }
+            }
+        }
+        return evaluated;
+
+        // Queue the samples at every combination of the first coordinates in xs, ys and zs
+        void Queue(int cx, int cy, int cz)
+        {
+            for (int i = 0; i < cx; i++)
+            {
+                for (int j = 0; j < cy; j++)
+                {
+                    int row = xs[i] * strideX + ys[j] * strideY;
+                    int local = ((xs[i] - lo.x) * sy + ys[j] - lo.y) * sz - lo.z;
+                    for (int k = 0; k < cz; k++)
+                    {
+                        ref var seen = ref known[local + zs[k]];
+                        if (!seen)
+                        {
+                            seen = true;
+                            pending.Add(row + zs[k]);
+                        }
+                    }
+                }
+            }
+        }
+
+        void Flush()
+        {
+            if (pending.Count == 0)
+                return;
+            evaluate(pending.ToArray());
+            evaluated += pending.Count;
+            pending.Clear();
+        }
+    }
+
+    /// <summary>
+    /// Largest magnitude at the corners of a block, given its first sample and
+    /// the offsets to the far corner along each axis
+    /// </summary>
+    private static double Farthest<T>(Span<T> values, int first, int x, int y, int z)
+        where T : unmanaged, INumberBase<T>
+    {
+        double farthest = 0;
+        for (int c = 0; c < 8; c++)
+        {
+            var value = values[first + ((c & 1) == 0 ? 0 : x) + ((c & 2) == 0 ? 0 : y) + ((c & 4) == 0 ? 0 : z)];
+            farthest = Math.Max(farthest, Math.Abs(double.CreateTruncating(value)));
+        }
+        return farthest;
+    }
+
+    /// <summary>
+    /// Sample coordinates splitting <paramref name="lo"/> to <paramref name="hi"/>
+    /// in half, or just its ends when it is a cell wide
+    /// </summary>
+    private static int Split(int lo, int hi, Span<int> at)
+    {
+        at[0] = lo;
+        if (hi - lo <= 1)
+        {
+            at[1] = hi;
+            return 2;
+        }
+        at[1] = lo + (hi - lo) / 2;
+        at[2] = hi;
+        return 3;
+    }
+
+    /// <summary>
+    /// The samples of a volume in memory order, z fastest
+    /// </summary>
+    public static Span<T> Flat<T>(T[,,] volume) where T : unmanaged =>
+        MemoryMarshal.CreateSpan(ref Unsafe.As<byte, T>(ref MemoryMarshal.GetArrayDataReference(volume)), volume.Length);
+
+    private readonly record struct Block(int X0, int Y0, int Z0, int X1, int Y1, int Z1);
+}
@@ -0,0 +1,65 @@
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace SDF;
+
+/// <summary>
+/// Runtime tier of one node under <see cref="TieredEvaluation"/>: the points it
+/// has handled so far, and the kernel or baked grid it was promoted to
+/// </summary>
+internal sealed class NodeTier
+{
+    private long _points;
+    private Task? _promotion;
+    private volatile Func<double, double, double, double>? _kernel;
+    private volatile BakedGrid? _grid;
+
+    /// <summary>
+    /// Fused kernel computing the subtree exactly, once compiled
+    /// </summary>
+    public Func<double, double, double, double>? Kernel => _kernel;
+
+    /// <summary>
+    /// Sampled distances of a static subtree, once baked
+    /// </summary>
+    public BakedGrid? Grid => _grid;
+
+    /// <summary>
+    /// Record that <paramref name="node"/> handled <paramref name="points"/>
+    /// more points, and start promoting it the first time the total passes
+    /// <see cref="TieredEvaluation.Threshold"/>
+    /// </summary>
+    public void Count(SDF3 node, int points)
+    {
+        if (Interlocked.Add(ref _points, points) < TieredEvaluation.Threshold || _promotion != null)
+            return;
+        // Promotion runs alongside evaluation, which keeps interpreting until it is done
+        var promotion = new Task(() => Promote(node));
+        if (Interlocked.CompareExchange(ref _promotion, promotion, null) == null)
+            promotion.Start();
+    }
+
+    /// <summary>
+    /// Promote <paramref name="node"/> now, or wait for a promotion already
+    /// under way, so its form no longer changes once this returns
+    /// </summary>
+    public void Settle(SDF3 node)
+    {
+        var promotion = new Task(() => Promote(node));
+        if (Interlocked.CompareExchange(ref _promotion, promotion, null) is { } running)
+            running.Wait();
+        else
+            promotion.RunSynchronously();
+    }
+
+    private void Promote(SDF3 node)
+    {
+        // A static subtree is compiled first, when it can be, so it evaluates
+        // exactly and fast while its grid is sampled
+        if (!node.HasCustom)
+            _kernel = Compiler.Compile(node);
+        if (node.BakeStep is { } step)
+            _grid = BakedGrid.Bake(node, step, _kernel);
+    }
+}
@@ -0,0 +1,534 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace SDF;
+
+/// <summary>
+/// Adaptive dual contouring on an octree over the sample grid. Nodes are
+/// refined one level at a time, every node of a level evaluated together. Each
+/// node is sampled on its half-size lattice. It becomes a leaf with one vertex
+/// once the tangent planes at the surface crossings on that lattice and the
+/// surface itself all pass within the tolerance of the vertex, provided
+/// merging the half-size cells keeps the surface's topology. Nodes the surface provably misses become
+/// empty leaves, so flat regions end in large leaves and curved or detailed
+/// ones in small leaves, down to single grid cells. Quads are then generated
+/// around every minimal edge the surface crosses by the cell, face and edge
+/// procedures of Ju et al., which join leaves of any sizes without cracks.
+/// </summary>
+internal sealed class OctreeMesher
+{
+    // Points evaluated per parallel work item
+    private const int Chunk = 4096;
+
+    // Nodes sampled together, which bounds the memory a level takes
+    private const int Group = 1 << 16;
+
+    private readonly SDF3 _sdf;
+    private readonly Vector3 _min;
+    private readonly double _step;
+    private readonly int _nx, _ny, _nz;
+    private readonly double _tolerance;
+    private readonly ParallelOptions _options;
+    private readonly double _lipschitz;
+    private long _evaluations;
+
+    private readonly List<Vector3> _vertices = new();
+    private readonly List<int> _indices = new();
+
+    /// <summary>
+    /// Mesher for the grid of <paramref name="cells"/> cells of size
+    /// <paramref name="step"/> starting at <paramref name="min"/>
+    /// </summary>
+    public OctreeMesher(SDF3 sdf, Vector3 min, double step, (int x, int y, int z) cells, double tolerance, int workers)
+    {
+        _sdf = sdf;
+        _min = min;
+        _step = step;
+        (_nx, _ny, _nz) = cells;
+        _tolerance = tolerance;
+        _options = new ParallelOptions { MaxDegreeOfParallelism = workers };
+        _lipschitz = sdf.LipschitzBound((min, min + new Vector3(_nx, _ny, _nz) * step));
+    }
+
+    /// <summary>
+    /// Points evaluated so far, counting gradient evaluations
+    /// </summary>
+    public long Evaluations => Interlocked.Read(ref _evaluations);
+
+    /// <summary>
+    /// Leaves holding a vertex
+    /// </summary>
+    public int Leaves { get; private set; }
+
+    /// <summary>
+    /// Build the octree and contour it into vertices and three indices per
+    /// triangle, counterclockwise seen from outside
+    /// </summary>
+    public (List<Vector3> vertices, List<int> indices) Run()
+    {
+        int size = 1;
+        while (size < Math.Max(_nx, Math.Max(_ny, _nz)))
+            size *= 2;
+
+        var root = new Node { Size = size };
+        var level = new List<Node> { root };
+        while (level.Count > 0)
+        {
+            var next = new List<Node>();
+            for (int start = 0; start < level.Count; start += Group)
+                next.AddRange(Refine(level.GetRange(start, Math.Min(Group, level.Count - start))));
+            level = next;
+        }
+
+        CellProc(root);
+        return (_vertices, _indices);
+    }
+
+    /// <summary>
+    /// Sample every node of a level, make each a leaf or split it, and return
+    /// the children that may hold surface
+    /// </summary>
+    private List<Node> Refine(List<Node> level)
+    {
+        // Nodes of one cell are sampled at their corners, larger ones on their half-size lattice
+        int size = level[0].Size;
+        int res = size == 1 ? 2 : 3;
+        int spacing = size == 1 ? 1 : size / 2;
+        int count = res * res * res;
+
+        var points = new Vector3[level.Count * count];
+        for (int n = 0; n < level.Count; n++)
+        {
+            var node = level[n];
+            for (int i = 0, p = n * count; i < res; i++)
+                for (int j = 0; j < res; j++)
+                    for (int k = 0; k < res; k++, p++)
+                        points[p] = Point(node.X + i * spacing, node.Y + j * spacing, node.Z + k * spacing);
+        }
+        var values = Evaluate(points);
+
+        // Crossings on the lattice edges, each lattice edge keyed by its first point and axis
+        var crossings = new List<Vector3>();
+        var edges = new List<int>();
+        var first = new int[level.Count + 1];
+        for (int n = 0; n < level.Count; n++)
+        {
+            first[n] = crossings.Count;
+            for (int i = 0, p = n * count; i < res; i++)
+            {
+                for (int j = 0; j < res; j++)
+                {
+                    for (int k = 0; k < res; k++, p++)
+                    {
+                        var v = values[p];
+                        if (i + 1 < res && (v < 0) != (values[p + res * res] < 0))
+                            Cross(p, 0, res * res);
+                        if (j + 1 < res && (v < 0) != (values[p + res] < 0))
+                            Cross(p, 1, res);
+                        if (k + 1 < res && (v < 0) != (values[p + 1] < 0))
+                            Cross(p, 2, 1);
+                    }
+                }
+            }
+        }
+        first[level.Count] = crossings.Count;
+
+        void Cross(int p, int axis, int stride)
+        {
+            var t = values[p] / (values[p] - values[p + stride]);
+            var along = spacing * _step * t;
+            crossings.Add(points[p] + new Vector3(axis == 0 ? along : 0, axis == 1 ? along : 0, axis == 2 ? along : 0));
+            edges.Add(p * 3 + axis);
+        }
+
+        // As in uniform dual contouring, crossings are moved onto the surface
+        // before their normals are taken
+        var at = crossings.ToArray();
+        var distances = Evaluate(at);
+        for (int c = 0; c < at.Length; c++)
+        {
+            int axis = edges[c] % 3, p = edges[c] / 3;
+            int q = p + (axis == 0 ? res * res : axis == 1 ? res : 1);
+            at[c] = Refine(at[c], distances[c], axis, values[p], values[q], spacing * _step);
+        }
+        var normals = Gradient(at);
+
+        var vertices = new Vector3[level.Count];
+        var merge = new bool[level.Count];
+        Parallel.For(0, level.Count, _options, n =>
+        {
+            (vertices[n], merge[n]) = Place(level[n], values.AsSpan(n * count, count),
+                at.AsSpan(first[n], first[n + 1] - first[n]), normals.AsSpan(first[n], first[n + 1] - first[n]));
+        });
+
+        // The planes only see the surface where it crosses the lattice, so a
+        // merged vertex must also lie within the tolerance of the surface itself
+        var candidates = new List<int>();
+        for (int n = 0; n < level.Count; n++)
+        {
+            if (merge[n])
+                candidates.Add(n);
+        }
+        var fields = Evaluate(candidates.ConvertAll(n => vertices[n]).ToArray());
+        for (int c = 0; c < candidates.Count; c++)
+            merge[candidates[c]] = Math.Abs(fields[c]) <= _tolerance;
+
+        var children = new Node[level.Count][];
+        Parallel.For(0, level.Count, _options, n =>
+        {
+            children[n] = Decide(level[n], values.AsSpan(n * count, count), res,
+                first[n + 1] > first[n], vertices[n], merge[n]);
+        });
+
+        var next = new List<Node>();
+        foreach (var group in children)
+        {
+            foreach (var child in group)
+            {
+                if (child.Children == null && child.Corners == null && !child.Empty && !child.Outside)
+                    next.Add(child);
+            }
+        }
+        return next;
+    }
+
+    /// <summary>
+    /// Vertex of <paramref name="node"/> from the crossings on its lattice, and
+    /// whether it may stand for the whole node: it lies within the grid, merging
+    /// keeps the topology, and the vertex is within the tolerance of every plane
+    /// </summary>
+    private (Vector3 vertex, bool merge) Place(Node node, ReadOnlySpan<double> lattice, ReadOnlySpan<Vector3> points,
+        ReadOnlySpan<Vector3> normals)
+    {
+        if (points.Length == 0)
+            return (default, false);
+
+        var qef = new Qef();
+        for (int c = 0; c < points.Length; c++)
+            qef.Add(points[c], normals[c]);
+        var lo = Point(node.X, node.Y, node.Z);
+        var hi = Point(node.X + node.Size, node.Y + node.Size, node.Z + node.Size);
+        var vertex = Vector3.Min(Vector3.Max(qef.Solve(), lo), hi);
+
+        if (node.Size == 1 || node.X + node.Size > _nx || node.Y + node.Size > _ny || node.Z + node.Size > _nz
+            || !SafeToMerge(lattice))
+            return (vertex, false);
+        double error = 0;
+        for (int c = 0; c < points.Length; c++)
+            error = Math.Max(error, Math.Abs(Vector3.Dot(normals[c], vertex - points[c])));
+        return (vertex, error <= _tolerance);
+    }
+
+    /// <summary>
+    /// Make <paramref name="node"/> a leaf, or split it and return its children
+    /// that still need refining alongside those settled at once
+    /// </summary>
+    private Node[] Decide(Node node, ReadOnlySpan<double> lattice, int res, bool crossed, Vector3 vertex, bool merge)
+    {
+        if (crossed)
+        {
+            if (merge || node.Size == 1)
+            {
+                node.Corners = Corners(lattice, res);
+                node.Vertex = vertex;
+                return Array.Empty<Node>();
+            }
+        }
+        else if (node.Size == 1)
+        {
+            node.Empty = true;
+            return Array.Empty<Node>();
+        }
+
+        // The lattice holds every child's corners
+        int half = node.Size / 2;
+        var children = new Node[8];
+        for (int c = 0; c < 8; c++)
+        {
+            int bx = c & 1, by = (c >> 1) & 1, bz = c >> 2;
+            var child = new Node { X = node.X + bx * half, Y = node.Y + by * half, Z = node.Z + bz * half, Size = half };
+            children[c] = child;
+            if (child.X >= _nx || child.Y >= _ny || child.Z >= _nz)
+            {
+                child.Outside = true;
+                continue;
+            }
+
+            // Empty when a corner is farther from the surface than the child is wide,
+            // or when interval arithmetic rules the surface out
+            var corner = lattice[(bx * res + by) * res + bz];
+            var diagonal = Math.Sqrt(3) * half * _step;
+            if (Math.Abs(corner) > _lipschitz * diagonal)
+            {
+                child.Empty = true;
+                continue;
+            }
+            var range = _sdf.EvaluateInterval((Point(child.X, child.Y, child.Z),
+                Point(child.X + half, child.Y + half, child.Z + half)));
+            if (range.Lo > 0 || range.Hi < 0)
+                child.Empty = true;
+        }
+        node.Children = children;
+        return children;
+    }
+
+    /// <summary>
+    /// Whether one cell can stand for the half-size cells of a 3x3x3 lattice
+    /// without changing the surface's topology: the midpoint of every edge and
+    /// face and the center agree in sign with at least one of the corners they
+    /// lie between (Ju et al., section 4.2)
+    /// </summary>
+    private static bool SafeToMerge(ReadOnlySpan<double> lattice)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    if (i != 1 && j != 1 && k != 1)
+                        continue;
+                    bool inside = lattice[(i * 3 + j) * 3 + k] < 0, agrees = false;
+                    for (int c = 0; c < 8 && !agrees; c++)
+                    {
+                        int ci = (c & 1) * 2, cj = ((c >> 1) & 1) * 2, ck = (c >> 2) * 2;
+                        // Only the corners of the edge, face or cell the point is the middle of
+                        if ((i != 1 && ci != i) || (j != 1 && cj != j) || (k != 1 && ck != k))
+                            continue;
+                        agrees = (lattice[(ci * 3 + cj) * 3 + ck] < 0) == inside;
+                    }
+                    if (!agrees)
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    private static double[] Corners(ReadOnlySpan<double> lattice, int res)
+    {
+        var corners = new double[8];
+        for (int c = 0; c < 8; c++)
+        {
+            int i = (c & 1) * (res - 1), j = ((c >> 1) & 1) * (res - 1), k = (c >> 2) * (res - 1);
+            corners[c] = lattice[(i * res + j) * res + k];
+        }
+        return corners;
+    }
+
+    // Contouring. Children are indexed x | y << 1 | z << 2, and the four nodes
+    // around an edge along axis e as u | v << 1 over the next two axes
+    // u = e + 1 and v = e + 2, counted from the low side of the edge.
+
+    private void CellProc(Node node)
+    {
+        if (node.Children is not { } c)
+            return;
+
+        for (int i = 0; i < 8; i++)
+            CellProc(c[i]);
+        for (int a = 0; a < 3; a++)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                if ((i & 1 << a) == 0)
+                    FaceProc(c[i], c[i | 1 << a], a);
+            }
+        }
+        var around = new Node[4];
+        for (int e = 0; e < 3; e++)
+        {
+            int u = (e + 1) % 3, v = (e + 2) % 3;
+            for (int t = 0; t < 2; t++)
+            {
+                for (int j = 0; j < 4; j++)
+                    around[j] = c[t << e | (j & 1) << u | (j >> 1) << v];
+                EdgeProc(around, e);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Contour the face between <paramref name="low"/> and <paramref name="high"/>,
+    /// neighbors along axis <paramref name="a"/>
+    /// </summary>
+    private void FaceProc(Node low, Node high, int a)
+    {
+        if (low.Children == null && high.Children == null)
+            return;
+
+        int b = (a + 1) % 3, c = (a + 2) % 3;
+        for (int p = 0; p < 4; p++)
+        {
+            int bits = (p & 1) << b | (p >> 1) << c;
+            FaceProc(Child(low, bits | 1 << a), Child(high, bits), a);
+        }
+
+        var around = new Node[4];
+        for (int k = 1; k <= 2; k++)
+        {
+            int e = (a + k) % 3, w = 3 - a - e, u = (e + 1) % 3;
+            for (int t = 0; t < 2; t++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    int su = j & 1, sv = j >> 1;
+                    int sideA = a == u ? su : sv, sideW = w == u ? su : sv;
+                    around[j] = Child(sideA == 0 ? low : high, t << e | (1 - sideA) << a | sideW << w);
+                }
+                EdgeProc(around, e);
+            }
+        }
+    }
+
+    private void EdgeProc(Node[] around, int e)
+    {
+        int u = (e + 1) % 3, v = (e + 2) % 3;
+        if (around[0].Children == null && around[1].Children == null &&
+            around[2].Children == null && around[3].Children == null)
+        {
+            Emit(around, e, u, v);
+            return;
+        }
+
+        var inner = new Node[4];
+        for (int t = 0; t < 2; t++)
+        {
+            for (int j = 0; j < 4; j++)
+                inner[j] = Child(around[j], t << e | (1 - (j & 1)) << u | (1 - (j >> 1)) << v);
+            EdgeProc(inner, e);
+        }
+    }
+
+    /// <summary>
+    /// Quad around a minimal edge, read from the smallest of the four leaves
+    /// around it, when the surface crosses the edge
+    /// </summary>
+    private void Emit(Node[] around, int e, int u, int v)
+    {
+        int smallest = 0;
+        for (int j = 0; j < 4; j++)
+        {
+            if (around[j].Outside || around[j].Empty)
+                return;
+            if (around[j].Size < around[smallest].Size)
+                smallest = j;
+        }
+
+        int corner = (1 - (smallest & 1)) << u | (1 - (smallest >> 1)) << v;
+        var corners = around[smallest].Corners!;
+        double v0 = corners[corner], v1 = corners[corner | 1 << e];
+        if ((v0 < 0) == (v1 < 0))
+            return;
+
+        int q0 = Index(around[0]), q1 = Index(around[1]), q2 = Index(around[3]), q3 = Index(around[2]);
+        if (v0 >= 0)
+            (q1, q3) = (q3, q1);
+
+        // Leaves larger than their neighbors take up two places around the edge,
+        // leaving a triangle
+        var p = _vertices;
+        if ((p[q0] - p[q2]).LengthSquared() <= (p[q1] - p[q3]).LengthSquared())
+        {
+            Triangle(q0, q1, q2);
+            Triangle(q0, q2, q3);
+        }
+        else
+        {
+            Triangle(q0, q1, q3);
+            Triangle(q1, q2, q3);
+        }
+    }
+
+    private void Triangle(int a, int b, int c)
+    {
+        if (a == b || b == c || c == a)
+            return;
+        _indices.Add(a);
+        _indices.Add(b);
+        _indices.Add(c);
+    }
+
+    private int Index(Node leaf)
+    {
+        if (leaf.Index < 0)
+        {
+            leaf.Index = _vertices.Count;
+            _vertices.Add(leaf.Vertex);
+            Leaves++;
+        }
+        return leaf.Index;
+    }
+
+    private static Node Child(Node node, int index) => node.Children?[index] ?? node;
+
+    private Vector3 Point(int x, int y, int z) =>
+        new(_min.X + x * _step, _min.Y + y * _step, _min.Z + z * _step);
+
+    private static Vector3 Refine(Vector3 point, double distance, int axis, double v0, double v1, double length)
+    {
+        var t = v0 / (v0 - v1);
+        var refined = (distance < 0) == (v0 < 0)
+            ? t + (1 - t) * distance / (distance - v1)
+            : t * v0 / (v0 - distance);
+        if (double.IsNaN(refined))
+            return point;
+
+        var delta = (Math.Clamp(refined, 0.0, 1.0) - t) * length;
+        return axis switch
+        {
+            0 => new Vector3(point.X + delta, point.Y, point.Z),
+            1 => new Vector3(point.X, point.Y + delta, point.Z),
+            _ => new Vector3(point.X, point.Y, point.Z + delta),
+        };
+    }
+
+    private double[] Evaluate(Vector3[] points)
+    {
+        var values = new double[points.Length];
+        Parallel.For(0, (points.Length + Chunk - 1) / Chunk, _options, c =>
+        {
+            int start = c * Chunk, length = Math.Min(Chunk, points.Length - start);
+            _sdf.Evaluate(points.AsSpan(start, length).ToArray()).CopyTo(values, start);
+        });
+        Interlocked.Add(ref _evaluations, points.Length);
+        return values;
+    }
+
+    /// <summary>
+    /// Unit normals at the points, zero where the gradient is not finite
+    /// </summary>
+    private Vector3[] Gradient(Vector3[] points)
+    {
+        var normals = new Vector3[points.Length];
+        Parallel.For(0, (points.Length + Chunk - 1) / Chunk, _options, c =>
+        {
+            int start = c * Chunk, length = Math.Min(Chunk, points.Length - start);
+            _sdf.EvaluateWithGradient(points.AsSpan(start, length).ToArray(), out var gradients);
+            for (int i = 0; i < length; i++)
+            {
+                var n = gradients[i];
+                normals[start + i] = double.IsFinite(n.X + n.Y + n.Z) ? n.Normalize() : Vector3.Zero;
+            }
+        });
+        Interlocked.Add(ref _evaluations, points.Length);
+        return normals;
+    }
+
+    private sealed class Node
+    {
+        // Lowest grid cell and edge length in cells
+        public int X, Y, Z, Size;
+        public Node[]? Children;
+
+        // Leaves with surface keep their corner values, x | y << 1 | z << 2, and vertex
+        public double[]? Corners;
+        public Vector3 Vertex;
+        public int Index = -1;
+
+        // Leaves without surface, and those beyond the grid, which are never meshed
+        public bool Empty, Outside;
+    }
+}
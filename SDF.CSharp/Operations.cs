@@ -1,4 +1,6 @@
 using System;
+using System.Collections.Generic;
+using System.Linq;
 using System.Numerics;
 
 namespace SDF;
@@ -20,17 +22,23 @@ public static class Operations
             return SmoothUnion(a, b, k.Value);
         }
 
-        return new SDF3(points =>
-        {
-            var da = a.Evaluate(points);
-            var db = b.Evaluate(points);
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                result[i] = Math.Min(da[i], db[i]);
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Union, Array.Empty<double>(), a, b);
+    }
+
+    /// <summary>
+    /// Union of any number of SDFs in a single node. A bounding volume hierarchy
+    /// over the children's bounds lets evaluation skip children far from each
+    /// point. With <paramref name="k"/> the two closest children are blended.
+    /// </summary>
+    public static SDF3 Union(IEnumerable<SDF3> shapes, double? k = null)
+    {
+        var children = shapes.ToArray();
+        if (children.Length == 0)
+            throw new ArgumentException("Union requires at least one shape", nameof(shapes));
+        if (children.Length == 1)
+            return children[0];
+
+        return new SDF3(SdfNodeKind.NaryUnion, new[] { Math.Max(k ?? 0, 0) }, children);
     }
 
     /// <summary>
@@ -38,18 +46,7 @@ public static class Operations
     /// </summary>
     public static SDF3 SmoothUnion(SDF3 a, SDF3 b, double k)
     {
-        return new SDF3(points =>
-        {
-            var da = a.Evaluate(points);
-            var db = b.Evaluate(points);
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var h = Math.Max(k - Math.Abs(da[i] - db[i]), 0.0) / k;
-                result[i] = Math.Min(da[i], db[i]) - h * h * k * (1.0 / 4.0);
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.SmoothUnion, new[] { k }, a, b);
     }
 
     /// <summary>
@@ -64,17 +61,7 @@ public static class Operations
             return SmoothDifference(a, b, k.Value);
         }
 
-        return new SDF3(points =>
-        {
-            var da = a.Evaluate(points);
-            var db = b.Evaluate(points);
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                result[i] = Math.Max(da[i], -db[i]);
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Difference, Array.Empty<double>(), a, b);
     }
 
     /// <summary>
@@ -82,18 +69,7 @@ public static class Operations
     /// </summary>
     public static SDF3 SmoothDifference(SDF3 a, SDF3 b, double k)
     {
-        return new SDF3(points =>
-        {
-            var da = a.Evaluate(points);
-            var db = b.Evaluate(points);
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var h = Math.Max(k - Math.Abs(-db[i] - da[i]), 0.0) / k;
-                result[i] = Math.Max(-db[i], da[i]) + h * h * k * (1.0 / 4.0);
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.SmoothDifference, new[] { k }, a, b);
     }
 
     /// <summary>
@@ -108,17 +84,7 @@ public static class Operations
             return SmoothIntersection(a, b, k.Value);
         }
 
-        return new SDF3(points =>
-        {
-            var da = a.Evaluate(points);
-            var db = b.Evaluate(points);
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                result[i] = Math.Max(da[i], db[i]);
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Intersection, Array.Empty<double>(), a, b);
     }
 
     /// <summary>
@@ -126,18 +92,7 @@ public static class Operations
     /// </summary>
     public static SDF3 SmoothIntersection(SDF3 a, SDF3 b, double k)
     {
-        return new SDF3(points =>
-        {
-            var da = a.Evaluate(points);
-            var db = b.Evaluate(points);
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var h = Math.Max(k - Math.Abs(da[i] - db[i]), 0.0) / k;
-                result[i] = Math.Max(da[i], db[i]) + h * h * k * (1.0 / 4.0);
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.SmoothIntersection, new[] { k }, a, b);
     }
 
     /// <summary>
@@ -145,15 +100,7 @@ public static class Operations
     /// </summary>
     public static SDF3 Translate(this SDF3 sdf, Vector3 offset)
     {
-        return new SDF3(points =>
-        {
-            var translatedPoints = new Vector3[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                translatedPoints[i] = points[i] - offset;
-            }
-            return sdf.Evaluate(translatedPoints);
-        });
+        return new SDF3(SdfNodeKind.Translate, new[] { offset.X, offset.Y, offset.Z }, sdf);
     }
 
     /// <summary>
@@ -161,20 +108,7 @@ public static class Operations
     /// </summary>
     public static SDF3 Scale(this SDF3 sdf, double factor)
     {
-        return new SDF3(points =>
-        {
-            var scaled = new Vector3[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                scaled[i] = points[i] / (float)factor;
-            }
-            var result = sdf.Evaluate(scaled);
-            for (int i = 0; i < result.Length; i++)
-            {
-                result[i] *= factor;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Scale, new[] { factor }, sdf);
     }
 
     /// <summary>
@@ -182,23 +116,8 @@ public static class Operations
     /// </summary>
     public static SDF3 Rotate(this SDF3 sdf, double angle, Vector3? axis = null)
     {
-        var rotAxis = axis ?? Constants.Z;
-        var normalized = Vector3.Normalize(rotAxis);
-        var cos = (float)Math.Cos(angle);
-        var sin = (float)Math.Sin(angle);
-
-        return new SDF3(points =>
-        {
-            var rotated = new Vector3[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                var dot = Vector3.Dot(p, normalized);
-                var cross = Vector3.Cross(normalized, p);
-                rotated[i] = normalized * dot + cross * sin + (p - normalized * dot) * cos;
-            }
-            return sdf.Evaluate(rotated);
-        });
+        var normalized = Vector3.Normalize(axis ?? Constants.Z);
+        return new SDF3(SdfNodeKind.Rotate, new[] { angle, normalized.X, normalized.Y, normalized.Z }, sdf);
     }
 
     /// <summary>
@@ -228,18 +147,7 @@ public static class Operations
     /// </summary>
     public static SDF3 Twist(this SDF3 sdf, double k)
     {
-        return new SDF3(points =>
-        {
-            var twisted = new Vector3[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                var c = (float)Math.Cos(k * p.Z);
-                var s = (float)Math.Sin(k * p.Z);
-                twisted[i] = new Vector3(c * p.X - s * p.Y, s * p.X + c * p.Y, p.Z);
-            }
-            return sdf.Evaluate(twisted);
-        });
+        return new SDF3(SdfNodeKind.Twist, new[] { k }, sdf);
     }
 
     /// <summary>
@@ -247,18 +155,7 @@ public static class Operations
     /// </summary>
     public static SDF3 Bend(this SDF3 sdf, double k)
     {
-        return new SDF3(points =>
-        {
-            var bent = new Vector3[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                var c = (float)Math.Cos(k * p.X);
-                var s = (float)Math.Sin(k * p.X);
-                bent[i] = new Vector3(c * p.X - s * p.Y, s * p.X + c * p.Y, p.Z);
-            }
-            return sdf.Evaluate(bent);
-        });
+        return new SDF3(SdfNodeKind.Bend, new[] { k }, sdf);
     }
 
     /// <summary>
@@ -266,41 +163,7 @@ public static class Operations
     /// </summary>
     public static SDF3 Elongate(this SDF3 sdf, Vector3 size)
     {
-        return new SDF3(points =>
-        {
-            var elongatedPoints = new Vector3[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                var q = new Vector3(
-                    Math.Abs(p.X) - size.X,
-                    Math.Abs(p.Y) - size.Y,
-                    Math.Abs(p.Z) - size.Z
-                );
-                elongatedPoints[i] = new Vector3(
-                    Math.Sign(p.X) * Math.Max(q.X, 0),
-                    Math.Sign(p.Y) * Math.Max(q.Y, 0),
-                    Math.Sign(p.Z) * Math.Max(q.Z, 0)
-                );
-            }
-            var result = sdf.Evaluate(elongatedPoints);
-            for (int i = 0; i < result.Length; i++)
-            {
-                var p = points[i];
-                var q = new Vector3(
-                    Math.Abs(p.X) - size.X,
-                    Math.Abs(p.Y) - size.Y,
-                    Math.Abs(p.Z) - size.Z
-                );
-                var outside = new Vector3(
-                    Math.Max(q.X, 0),
-                    Math.Max(q.Y, 0),
-                    Math.Max(q.Z, 0)
-                ).Length();
-                result[i] += outside;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Elongate, new[] { size.X, size.Y, size.Z }, sdf);
     }
 
     /// <summary>
@@ -308,15 +171,7 @@ public static class Operations
     /// </summary>
     public static SDF3 Dilate(this SDF3 sdf, double r)
     {
-        return new SDF3(points =>
-        {
-            var result = sdf.Evaluate(points);
-            for (int i = 0; i < result.Length; i++)
-            {
-                result[i] -= r;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Dilate, new[] { r }, sdf);
     }
 
     /// <summary>
@@ -324,15 +179,7 @@ public static class Operations
     /// </summary>
     public static SDF3 Erode(this SDF3 sdf, double r)
     {
-        return new SDF3(points =>
-        {
-            var result = sdf.Evaluate(points);
-            for (int i = 0; i < result.Length; i++)
-            {
-                result[i] += r;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Erode, new[] { r }, sdf);
     }
 
     /// <summary>
@@ -340,48 +187,20 @@ public static class Operations
     /// </summary>
     public static SDF3 Shell(this SDF3 sdf, double thickness)
     {
-        return new SDF3(points =>
-        {
-            var result = sdf.Evaluate(points);
-            for (int i = 0; i < result.Length; i++)
-            {
-                result[i] = Math.Abs(result[i]) - thickness;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Shell, new[] { thickness }, sdf);
     }
 
     /// <summary>
-    /// Repeat an SDF with specified spacing
+    /// Repeat an SDF with specified spacing. A zero spacing leaves that axis
+    /// unrepeated. Instances wider than their cell need a
+    /// <paramref name="padding"/> of neighboring cells to be taken into account;
+    /// neighbors are only evaluated where their bounds can beat the nearer instances.
     /// </summary>
-    public static SDF3 Repeat(this SDF3 sdf, Vector3 spacing, Vector3? count = null)
+    public static SDF3 Repeat(this SDF3 sdf, Vector3 spacing, Vector3? count = null, int padding = 0)
     {
-        return new SDF3(points =>
-        {
-            var repeated = new Vector3[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                if (count.HasValue)
-                {
-                    var c = count.Value;
-                    var q = new Vector3(
-                        p.X - spacing.X * (float)Math.Round(Math.Clamp(p.X / spacing.X, -c.X, c.X)),
-                        p.Y - spacing.Y * (float)Math.Round(Math.Clamp(p.Y / spacing.Y, -c.Y, c.Y)),
-                        p.Z - spacing.Z * (float)Math.Round(Math.Clamp(p.Z / spacing.Z, -c.Z, c.Z))
-                    );
-                    repeated[i] = q;
-                }
-                else
-                {
-                    repeated[i] = new Vector3(
-                        p.X - spacing.X * (float)Math.Round(p.X / spacing.X),
-                        p.Y - spacing.Y * (float)Math.Round(p.Y / spacing.Y),
-                        p.Z - spacing.Z * (float)Math.Round(p.Z / spacing.Z)
-                    );
-                }
-            }
-            return sdf.Evaluate(repeated);
-        });
+        if (padding < 0)
+            throw new ArgumentOutOfRangeException(nameof(padding), "Padding must not be negative");
+        var c = count ?? new Vector3(double.PositiveInfinity, double.PositiveInfinity, double.PositiveInfinity);
+        return new SDF3(SdfNodeKind.Repeat, new[] { spacing.X, spacing.Y, spacing.Z, c.X, c.Y, c.Z, padding }, sdf);
     }
 }
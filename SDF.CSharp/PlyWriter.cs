@@ -0,0 +1,44 @@
+using System.IO;
+using System.Text;
+
+namespace SDF;
+
+/// <summary>
+/// Write binary PLY files
+/// </summary>
+public static class PlyWriter
+{
+    /// <summary>
+    /// Write an indexed mesh to a little-endian binary PLY file, keeping each
+    /// vertex once
+    /// </summary>
+    public static void WriteBinaryPly(string path, IndexedMesh mesh)
+    {
+        using var writer = new BinaryWriter(File.Open(path, FileMode.Create));
+
+        var header = new StringBuilder()
+            .Append("ply\n")
+            .Append("format binary_little_endian 1.0\n")
+            .Append("comment generated by SDF.CSharp\n")
+            .Append($"element vertex {mesh.VertexCount}\n")
+            .Append("property float x\n")
+            .Append("property float y\n")
+            .Append("property float z\n")
+            .Append($"element face {mesh.TriangleCount}\n")
+            .Append("property list uchar uint vertex_indices\n")
+            .Append("end_header\n");
+        writer.Write(Encoding.ASCII.GetBytes(header.ToString()));
+
+        foreach (var value in mesh.Vertices)
+            writer.Write(value);
+
+        var indices = mesh.Indices;
+        for (int i = 0; i < indices.Length; i += 3)
+        {
+            writer.Write((byte)3);
+            writer.Write(indices[i]);
+            writer.Write(indices[i + 1]);
+            writer.Write(indices[i + 2]);
+        }
+    }
+}
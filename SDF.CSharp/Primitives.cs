@@ -15,16 +15,7 @@ public static class Primitives
     public static SDF3 Sphere(double radius = 1.0, Vector3? center = null)
     {
         var c = center ?? Constants.Origin;
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var diff = points[i] - c;
-                result[i] = diff.Length() - radius;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Sphere, new[] { radius, c.X, c.Y, c.Z });
     }
 
     /// <summary>
@@ -33,25 +24,7 @@ public static class Primitives
     public static SDF3 Box(Vector3 size, Vector3? center = null)
     {
         var c = center ?? Constants.Origin;
-        var halfSize = size / 2.0f;
-        
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i] - c;
-                var q = new Vector3(
-                    Math.Abs(p.X) - halfSize.X,
-                    Math.Abs(p.Y) - halfSize.Y,
-                    Math.Abs(p.Z) - halfSize.Z
-                );
-                var outside = Vector3.Max(q, Vector3.Zero).Length();
-                var inside = Math.Min(Math.Max(q.X, Math.Max(q.Y, q.Z)), 0.0);
-                result[i] = outside + inside;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Box, new[] { size.X, size.Y, size.Z, c.X, c.Y, c.Z });
     }
 
     /// <summary>
@@ -67,17 +40,7 @@ public static class Primitives
     /// </summary>
     public static SDF3 Cylinder(double radius)
     {
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                var d = Math.Sqrt(p.X * p.X + p.Y * p.Y);
-                result[i] = d - radius;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Cylinder, new[] { radius });
     }
 
     /// <summary>
@@ -85,25 +48,7 @@ public static class Primitives
     /// </summary>
     public static SDF3 CappedCylinder(Vector3 a, Vector3 b, double radius)
     {
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            var ba = b - a;
-            var baba = Vector3.Dot(ba, ba);
-            
-            for (int i = 0; i < points.Length; i++)
-            {
-                var pa = points[i] - a;
-                var paba = Vector3.Dot(pa, ba);
-                var x = (pa * baba - ba * paba).Length() - radius * baba;
-                var y = Math.Abs(paba - baba * 0.5) - baba * 0.5;
-                var x2 = x * x;
-                var y2 = y * y * baba;
-                var d = (Math.Max(x, y) < 0) ? -Math.Min(x2, y2) : ((x > 0) ? x2 : 0) + ((y > 0) ? y2 : 0);
-                result[i] = Math.Sign(d) * Math.Sqrt(Math.Abs(d)) / baba;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.CappedCylinder, new[] { a.X, a.Y, a.Z, b.X, b.Y, b.Z, radius });
     }
 
     /// <summary>
@@ -113,16 +58,7 @@ public static class Primitives
     {
         var n = Vector3.Normalize(normal ?? Constants.Up);
         var pt = point ?? Constants.Origin;
-        
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                result[i] = Vector3.Dot(points[i] - pt, n);
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Plane, new[] { n.X, n.Y, n.Z, pt.X, pt.Y, pt.Z });
     }
 
     /// <summary>
@@ -130,18 +66,7 @@ public static class Primitives
     /// </summary>
     public static SDF3 Torus(double r1, double r2)
     {
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                var qx = Math.Sqrt(p.X * p.X + p.Y * p.Y) - r1;
-                var qy = p.Z;
-                result[i] = Math.Sqrt(qx * qx + qy * qy) - r2;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Torus, new[] { r1, r2 });
     }
 
     /// <summary>
@@ -149,25 +74,7 @@ public static class Primitives
     /// </summary>
     public static SDF3 RoundedBox(Vector3 size, double radius)
     {
-        var halfSize = size / 2.0 - new Vector3(radius, radius, radius);
-        
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                var q = new Vector3(
-                    Math.Abs(p.X) - halfSize.X,
-                    Math.Abs(p.Y) - halfSize.Y,
-                    Math.Abs(p.Z) - halfSize.Z
-                );
-                var outside = Vector3.Max(q, Vector3.Zero).Length();
-                var inside = Math.Min(Math.Max(q.X, Math.Max(q.Y, q.Z)), 0.0);
-                result[i] = outside + inside - radius;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.RoundedBox, new[] { size.X, size.Y, size.Z, radius });
     }
 
     /// <summary>
@@ -175,20 +82,7 @@ public static class Primitives
     /// </summary>
     public static SDF3 Capsule(Vector3 a, Vector3 b, double radius)
     {
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            var ba = b - a;
-            var baba = Vector3.Dot(ba, ba);
-            
-            for (int i = 0; i < points.Length; i++)
-            {
-                var pa = points[i] - a;
-                var h = Math.Clamp(Vector3.Dot(pa, ba) / baba, 0.0, 1.0);
-                result[i] = (pa - ba * (float)h).Length() - radius;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Capsule, new[] { a.X, a.Y, a.Z, b.X, b.Y, b.Z, radius });
     }
 
     /// <summary>
@@ -222,17 +116,6 @@ public static class Primitives
     /// </summary>
     public static SDF3 Ellipsoid(Vector3 size)
     {
-        return new SDF3(points =>
-        {
-            var result = new double[points.Length];
-            for (int i = 0; i < points.Length; i++)
-            {
-                var p = points[i];
-                var k0 = new Vector3(p.X / size.X, p.Y / size.Y, p.Z / size.Z).Length();
-                var k1 = new Vector3(p.X / (size.X * size.X), p.Y / (size.Y * size.Y), p.Z / (size.Z * size.Z)).Length();
-                result[i] = k0 * (k0 - 1.0) / k1;
-            }
-            return result;
-        });
+        return new SDF3(SdfNodeKind.Ellipsoid, new[] { size.X, size.Y, size.Z });
     }
 }
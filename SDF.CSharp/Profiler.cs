@@ -0,0 +1,266 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Globalization;
+using System.Linq;
+using System.Text;
+using System.Threading;
+
+namespace SDF;
+
+/// <summary>
+/// Opt-in per-node profiler for SDF evaluation. While a profiler is started,
+/// the interpreters record for every node the number of calls, points
+/// evaluated, inclusive and exclusive time, and bytes allocated, keyed by the
+/// node's path from the root. Fused kernels hide their nodes, so profiled mesh
+/// generation skips compilation and absolute times run higher than usual.
+/// </summary>
+/// <example>
+/// <code>
+/// var profiler = new Profiler();
+/// new MeshGenerator { Profiler = profiler }.Generate(sdf);
+/// Console.Write(profiler.Report());
+/// File.WriteAllText("scene.folded", profiler.FlameGraph());
+/// </code>
+/// </example>
+public sealed class Profiler
+{
+    private static readonly AsyncLocal<Profiler?> _current = new();
+
+    // Each thread records into its own tree, merged when a report is made
+    private readonly ThreadLocal<ThreadTree> _threads = new(() => new ThreadTree(), trackAllValues: true);
+
+    /// <summary>
+    /// Profiler started on the current thread or async flow, if any
+    /// </summary>
+    internal static Profiler? Current => _current.Value;
+
+    /// <summary>
+    /// Record evaluations on this thread and the tasks it starts until the
+    /// returned scope is disposed
+    /// </summary>
+    public IDisposable Start()
+    {
+        var scope = new Scope(_current.Value);
+        _current.Value = this;
+        return scope;
+    }
+
+    /// <summary>
+    /// Discard everything recorded so far
+    /// </summary>
+    public void Reset()
+    {
+        foreach (var tree in _threads.Values)
+            tree.Clear();
+    }
+
+    internal void Enter(SDF3 node, int points)
+    {
+        var tree = _threads.Value!;
+        var parent = tree.Current;
+        var key = new FrameKey(node);
+        if (!parent.Children.TryGetValue(key, out var entry))
+        {
+            entry = new Entry(key, parent);
+            parent.Children.Add(key, entry);
+        }
+        entry.Calls++;
+        entry.Points += points;
+        tree.Current = entry;
+        tree.Starts.Push((Stopwatch.GetTimestamp(), GC.GetAllocatedBytesForCurrentThread()));
+    }
+
+    internal void Exit()
+    {
+        var tree = _threads.Value!;
+        var (ticks, bytes) = tree.Starts.Pop();
+        ticks = Stopwatch.GetTimestamp() - ticks;
+        bytes = GC.GetAllocatedBytesForCurrentThread() - bytes;
+        var entry = tree.Current;
+        var parent = entry.Parent!;
+        entry.Ticks += ticks;
+        entry.Bytes += bytes;
+        parent.ChildTicks += ticks;
+        parent.ChildBytes += bytes;
+        tree.Current = parent;
+    }
+
+    /// <summary>
+    /// Table of node paths sorted by exclusive time, limited to the
+    /// <paramref name="top"/> most expensive
+    /// </summary>
+    public string Report(int top = 25)
+    {
+        var rows = new List<(string path, Entry entry)>();
+        Flatten(Merge(), "", rows);
+        var total = rows.Sum(r => r.entry.ExclusiveTicks);
+
+        var text = new StringBuilder();
+        text.AppendLine(" excl %   excl ms   incl ms      calls        points   excl bytes  node");
+        foreach (var (path, entry) in rows.OrderByDescending(r => r.entry.ExclusiveTicks).Take(top))
+        {
+            text.AppendLine(string.Format(CultureInfo.InvariantCulture,
+                "{0,6:F1}  {1,8:F1}  {2,8:F1}  {3,9}  {4,12}  {5,11}  {6}",
+                total > 0 ? 100.0 * entry.ExclusiveTicks / total : 0,
+                Milliseconds(entry.ExclusiveTicks), Milliseconds(entry.Ticks),
+                entry.Calls, entry.Points, entry.Bytes - entry.ChildBytes, path));
+        }
+        return text.ToString();
+    }
+
+    /// <summary>
+    /// Folded stacks, one line per node path with its exclusive time in
+    /// microseconds, as read by flamegraph.pl and speedscope
+    /// </summary>
+    public string FlameGraph()
+    {
+        var rows = new List<(string path, Entry entry)>();
+        Flatten(Merge(), "", rows, ";");
+
+        var text = new StringBuilder();
+        foreach (var (path, entry) in rows)
+        {
+            var micros = (long)(Milliseconds(entry.ExclusiveTicks) * 1000);
+            if (micros > 0)
+                text.Append(path).Append(' ').Append(micros.ToString(CultureInfo.InvariantCulture)).Append('\n');
+        }
+        return text.ToString();
+    }
+
+    private static double Milliseconds(long ticks) => ticks * 1000.0 / Stopwatch.Frequency;
+
+    private Entry Merge()
+    {
+        var root = new Entry(default, null);
+        foreach (var tree in _threads.Values)
+            MergeInto(root, tree.Root);
+        return root;
+    }
+
+    private static void MergeInto(Entry target, Entry source)
+    {
+        target.Calls += source.Calls;
+        target.Points += source.Points;
+        target.Ticks += source.Ticks;
+        target.ChildTicks += source.ChildTicks;
+        target.Bytes += source.Bytes;
+        target.ChildBytes += source.ChildBytes;
+        foreach (var (key, child) in source.Children)
+        {
+            if (!target.Children.TryGetValue(key, out var merged))
+            {
+                merged = new Entry(key, target);
+                target.Children.Add(key, merged);
+            }
+            MergeInto(merged, child);
+        }
+    }
+
+    private static void Flatten(Entry entry, string prefix, List<(string, Entry)> rows, string separator = " / ")
+    {
+        foreach (var child in entry.Children.Values)
+        {
+            var path = prefix.Length == 0 ? child.Key.Label : prefix + separator + child.Key.Label;
+            rows.Add((path, child));
+            Flatten(child, path, rows, separator);
+        }
+    }
+
+    /// <summary>
+    /// Identifies a node by its kind and arguments, so the pruned copies made
+    /// per batch land on the same entry as the node they came from
+    /// </summary>
+    private readonly struct FrameKey : IEquatable<FrameKey>
+    {
+        private readonly SdfNodeKind _kind;
+        private readonly double[] _args;
+        private readonly Delegate? _function;
+
+        public FrameKey(SDF3 node)
+        {
+            _kind = node.Kind;
+            _args = node.Args;
+            _function = node.Function;
+        }
+
+        public string Label
+        {
+            get
+            {
+                // Affine arguments are a matrix, which reads better as just the name
+                if (_args.Length == 0 || _kind == SdfNodeKind.Affine)
+                    return _kind.ToString();
+                var args = string.Join(", ", _args.Select(a => a.ToString("G4", CultureInfo.InvariantCulture)));
+                return $"{_kind}({args})";
+            }
+        }
+
+        public bool Equals(FrameKey other) =>
+            _kind == other._kind && _function == other._function && _args.AsSpan().SequenceEqual(other._args);
+
+        public override bool Equals(object? obj) => obj is FrameKey other && Equals(other);
+
+        public override int GetHashCode()
+        {
+            var hash = new HashCode();
+            hash.Add(_kind);
+            hash.Add(_function);
+            foreach (var a in _args)
+                hash.Add(a);
+            return hash.ToHashCode();
+        }
+    }
+
+    private sealed class Entry
+    {
+        public Entry(FrameKey key, Entry? parent)
+        {
+            Key = key;
+            Parent = parent;
+        }
+
+        public FrameKey Key { get; }
+        public Entry? Parent { get; }
+        public Dictionary<FrameKey, Entry> Children { get; } = new();
+        public long Calls;
+        public long Points;
+        public long Ticks;
+        public long ChildTicks;
+        public long Bytes;
+        public long ChildBytes;
+
+        public long ExclusiveTicks => Ticks - ChildTicks;
+    }
+
+    private sealed class ThreadTree
+    {
+        public ThreadTree()
+        {
+            Current = Root;
+        }
+
+        public Entry Root { get; private set; } = new(default, null);
+        public Entry Current { get; set; }
+        public Stack<(long ticks, long bytes)> Starts { get; } = new();
+
+        public void Clear()
+        {
+            Root = new Entry(default, null);
+            Current = Root;
+            Starts.Clear();
+        }
+    }
+
+    private sealed class Scope : IDisposable
+    {
+        private readonly Profiler? _previous;
+
+        public Scope(Profiler? previous)
+        {
+            _previous = previous;
+        }
+
+        public void Dispose() => _current.Value = _previous;
+    }
+}
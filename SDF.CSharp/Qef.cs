@@ -0,0 +1,135 @@
+using System;
+
+namespace SDF;
+
+/// <summary>
+/// Quadratic error function of dual contouring: the sum of squared distances
+/// from a point to the tangent planes through a cell's edge crossings
+/// </summary>
+internal struct Qef
+{
+    // Directions whose eigenvalue is below this fraction of the largest are
+    // left at the mass point; planes that nearly agree do not pin them down
+    private const double Truncation = 0.02;
+
+    // Upper triangle of AᵀA and Aᵀb, one row of A per plane
+    private double _a00, _a01, _a02, _a11, _a12, _a22;
+    private double _b0, _b1, _b2;
+    private Vector3 _sum;
+
+    public int Count { get; private set; }
+
+    /// <summary>
+    /// Mean of the crossings, where the solution starts
+    /// </summary>
+    public Vector3 MassPoint => _sum / Count;
+
+    /// <summary>
+    /// Add the plane through <paramref name="point"/> with unit
+    /// <paramref name="normal"/>; a zero normal only moves the mass point
+    /// </summary>
+    public void Add(Vector3 point, Vector3 normal)
+    {
+        _sum += point;
+        Count++;
+
+        double nx = normal.X, ny = normal.Y, nz = normal.Z;
+        var d = Vector3.Dot(normal, point);
+        _a00 += nx * nx;
+        _a01 += nx * ny;
+        _a02 += nx * nz;
+        _a11 += ny * ny;
+        _a12 += ny * nz;
+        _a22 += nz * nz;
+        _b0 += nx * d;
+        _b1 += ny * d;
+        _b2 += nz * d;
+    }
+
+    /// <summary>
+    /// Point minimizing the error, solved from the mass point through the
+    /// eigenvectors of AᵀA with small eigenvalues dropped, so it stays at the
+    /// mass point along directions the planes leave free
+    /// </summary>
+    public Vector3 Solve()
+    {
+        var c = MassPoint;
+        Span<double> a = stackalloc double[] { _a00, _a01, _a02, _a01, _a11, _a12, _a02, _a12, _a22 };
+
+        // Residual Aᵀb - AᵀA c of the mass point
+        double r0 = _b0 - (a[0] * c.X + a[1] * c.Y + a[2] * c.Z);
+        double r1 = _b1 - (a[3] * c.X + a[4] * c.Y + a[5] * c.Z);
+        double r2 = _b2 - (a[6] * c.X + a[7] * c.Y + a[8] * c.Z);
+
+        Span<double> v = stackalloc double[9];
+        Eigen(a, v);
+        var largest = Math.Max(a[0], Math.Max(a[4], a[8]));
+        if (!(largest > 0))
+            return c;
+
+        double x = 0, y = 0, z = 0;
+        for (int k = 0; k < 3; k++)
+        {
+            var lambda = a[4 * k];
+            if (lambda < Truncation * largest)
+                continue;
+            // Component of the residual along eigenvector k, scaled by its inverse eigenvalue
+            var s = (v[k] * r0 + v[3 + k] * r1 + v[6 + k] * r2) / lambda;
+            x += v[k] * s;
+            y += v[3 + k] * s;
+            z += v[6 + k] * s;
+        }
+        return new Vector3(c.X + x, c.Y + y, c.Z + z);
+    }
+
+    /// <summary>
+    /// Diagonalize the symmetric row-major <paramref name="a"/> by Jacobi
+    /// rotations, leaving the eigenvalues on its diagonal and the eigenvectors
+    /// in the columns of <paramref name="v"/>
+    /// </summary>
+    private static void Eigen(Span<double> a, Span<double> v)
+    {
+        v.Clear();
+        v[0] = v[4] = v[8] = 1;
+        for (int sweep = 0; sweep < 8; sweep++)
+        {
+            var off = a[1] * a[1] + a[2] * a[2] + a[5] * a[5];
+            var diagonal = a[0] * a[0] + a[4] * a[4] + a[8] * a[8];
+            if (off <= 1e-24 * diagonal)
+                break;
+            Rotate(a, v, 0, 1);
+            Rotate(a, v, 0, 2);
+            Rotate(a, v, 1, 2);
+        }
+    }
+
+    private static void Rotate(Span<double> a, Span<double> v, int p, int q)
+    {
+        var apq = a[3 * p + q];
+        if (apq == 0)
+            return;
+
+        var theta = (a[3 * q + q] - a[3 * p + p]) / (2 * apq);
+        var t = (theta >= 0 ? 1 : -1) / (Math.Abs(theta) + Math.Sqrt(theta * theta + 1));
+        var c = 1 / Math.Sqrt(t * t + 1);
+        var s = t * c;
+        for (int k = 0; k < 3; k++)
+        {
+            double akp = a[3 * k + p], akq = a[3 * k + q];
+            a[3 * k + p] = c * akp - s * akq;
+            a[3 * k + q] = s * akp + c * akq;
+        }
+        for (int k = 0; k < 3; k++)
+        {
+            double apk = a[3 * p + k], aqk = a[3 * q + k];
+            a[3 * p + k] = c * apk - s * aqk;
+            a[3 * q + k] = s * apk + c * aqk;
+        }
+        for (int k = 0; k < 3; k++)
+        {
+            double vkp = v[3 * k + p], vkq = v[3 * k + q];
+            v[3 * k + p] = c * vkp - s * vkq;
+            v[3 * k + q] = s * vkp + c * vkq;
+        }
+    }
+}
@@ -0,0 +1,196 @@
+using System;
+using System.Buffers;
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Neighbor cells of a padded repeat. Every point evaluates the instance in its
+/// own cell first, then visits neighboring instances nearest first, and only
+/// where the child's bounding box placed in that cell is closer than the best
+/// value found so far. Children without finite bounds visit every neighbor.
+/// </summary>
+/// <remarks>
+/// As with <see cref="UnionBvh"/>, skipping an instance is exact when the child
+/// is at least as far as its box from any point outside it, which holds for
+/// distance fields.
+/// </remarks>
+internal sealed class RepeatNeighbors
+{
+    private readonly Vector3 _spacing;
+    private readonly Vector3 _count;
+    // Cell offsets other than (0, 0, 0), nearest first
+    private readonly (int x, int y, int z)[] _offsets;
+    private readonly (Vector3 min, Vector3 max)? _box;
+
+    public RepeatNeighbors(double[] args, SDF3 child)
+    {
+        _spacing = Evaluator.Vec(args, 0);
+        _count = Evaluator.Vec(args, 3);
+        _box = child.Bounds;
+
+        // Axes without spacing do not repeat, so they have no neighbors
+        var padding = (int)args[6];
+        int px = _spacing.X == 0 ? 0 : padding;
+        int py = _spacing.Y == 0 ? 0 : padding;
+        int pz = _spacing.Z == 0 ? 0 : padding;
+        var offsets = new List<(int x, int y, int z)>();
+        for (int i = -px; i <= px; i++)
+            for (int j = -py; j <= py; j++)
+                for (int k = -pz; k <= pz; k++)
+                    if (i != 0 || j != 0 || k != 0)
+                        offsets.Add((i, j, k));
+        offsets.Sort((a, b) => Shift(a).Length().CompareTo(Shift(b).Length()));
+        _offsets = offsets.ToArray();
+    }
+
+    private Vector3 Shift((int x, int y, int z) offset) =>
+        new(_spacing.X * offset.x, _spacing.Y * offset.y, _spacing.Z * offset.z);
+
+    private static double Cell(double p, double spacing, double count) =>
+        spacing == 0 ? 0 : Math.Round(Math.Clamp(p / spacing, -count, count));
+
+    private static float Cell(float p, float spacing, float count) =>
+        spacing == 0 ? 0 : MathF.Round(Math.Clamp(p / spacing, -count, count));
+
+    /// <summary>
+    /// Whether the instance at a cell offset from the home cell exists and can
+    /// still beat <paramref name="best"/> at the point (qx, qy, qz), given in
+    /// coordinates local to that instance
+    /// </summary>
+    private bool Visits((int x, int y, int z) offset, double ix, double iy, double iz,
+        double qx, double qy, double qz, double best)
+    {
+        if (Math.Abs(ix + offset.x) > _count.X || Math.Abs(iy + offset.y) > _count.Y || Math.Abs(iz + offset.z) > _count.Z)
+            return false;
+        if (_box is not { } box)
+            return true;
+        var dx = Math.Max(Math.Max(box.min.X - qx, qx - box.max.X), 0);
+        var dy = Math.Max(Math.Max(box.min.Y - qy, qy - box.max.Y), 0);
+        var dz = Math.Max(Math.Max(box.min.Z - qz, qz - box.max.Z), 0);
+        var distance = Math.Sqrt(dx * dx + dy * dy + dz * dz);
+        return distance <= 0 || distance < best;
+    }
+
+    /// <summary>
+    /// Evaluate the repeat at a single point with the child's compiled kernel
+    /// </summary>
+    public double Evaluate(double x, double y, double z, Func<double, double, double, double> kernel)
+    {
+        var ix = Cell(x, _spacing.X, _count.X);
+        var iy = Cell(y, _spacing.Y, _count.Y);
+        var iz = Cell(z, _spacing.Z, _count.Z);
+        var qx = x - _spacing.X * ix;
+        var qy = y - _spacing.Y * iy;
+        var qz = z - _spacing.Z * iz;
+        var best = kernel(qx, qy, qz);
+        foreach (var offset in _offsets)
+        {
+            var shift = Shift(offset);
+            double rx = qx - shift.X, ry = qy - shift.Y, rz = qz - shift.Z;
+            if (Visits(offset, ix, iy, iz, rx, ry, rz, best))
+                best = Math.Min(best, kernel(rx, ry, rz));
+        }
+        return best;
+    }
+
+    /// <summary>
+    /// Evaluate the repeat at many points, gathering the points each neighbor
+    /// can affect into one packet per neighbor
+    /// </summary>
+    public double[] Evaluate(SDF3 child, Vector3[] points)
+    {
+        int n = points.Length;
+        var cells = new Vector3[n];
+        var home = new Vector3[n];
+        for (int i = 0; i < n; i++)
+        {
+            var p = points[i];
+            cells[i] = new Vector3(Cell(p.X, _spacing.X, _count.X), Cell(p.Y, _spacing.Y, _count.Y), Cell(p.Z, _spacing.Z, _count.Z));
+            home[i] = new Vector3(p.X - _spacing.X * cells[i].X, p.Y - _spacing.Y * cells[i].Y, p.Z - _spacing.Z * cells[i].Z);
+        }
+        var best = Evaluator.Evaluate(child, home);
+
+        var active = ArrayPool<int>.Shared.Rent(n);
+        foreach (var offset in _offsets)
+        {
+            var shift = Shift(offset);
+            int m = 0;
+            for (int i = 0; i < n; i++)
+            {
+                var q = home[i] - shift;
+                if (Visits(offset, cells[i].X, cells[i].Y, cells[i].Z, q.X, q.Y, q.Z, best[i]))
+                    active[m++] = i;
+            }
+            if (m == 0)
+                continue;
+
+            var gathered = new Vector3[m];
+            for (int j = 0; j < m; j++)
+                gathered[j] = home[active[j]] - shift;
+            var values = Evaluator.Evaluate(child, gathered);
+            for (int j = 0; j < m; j++)
+                best[active[j]] = Math.Min(best[active[j]], values[j]);
+        }
+        ArrayPool<int>.Shared.Return(active);
+        return best;
+    }
+
+    /// <summary>
+    /// Evaluate the repeat over structure-of-arrays float lanes, gathering the
+    /// points each neighbor can affect into scratch buffers
+    /// </summary>
+    public void Evaluate(SDF3 child, ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z,
+        Span<float> d, EvalScratch scratch)
+    {
+        int n = d.Length;
+        float sx = (float)_spacing.X, sy = (float)_spacing.Y, sz = (float)_spacing.Z;
+        float cx = (float)_count.X, cy = (float)_count.Y, cz = (float)_count.Z;
+        var mark = scratch.Mark;
+        var ix = scratch.Rent(n);
+        var iy = scratch.Rent(n);
+        var iz = scratch.Rent(n);
+        var hx = scratch.Rent(n);
+        var hy = scratch.Rent(n);
+        var hz = scratch.Rent(n);
+        for (int i = 0; i < n; i++)
+        {
+            ix[i] = Cell(x[i], sx, cx);
+            iy[i] = Cell(y[i], sy, cy);
+            iz[i] = Cell(z[i], sz, cz);
+            hx[i] = x[i] - sx * ix[i];
+            hy[i] = y[i] - sy * iy[i];
+            hz[i] = z[i] - sz * iz[i];
+        }
+        Evaluator.Evaluate(child, hx, hy, hz, d, scratch);
+
+        var active = ArrayPool<int>.Shared.Rent(n);
+        var gx = scratch.Rent(n);
+        var gy = scratch.Rent(n);
+        var gz = scratch.Rent(n);
+        var values = scratch.Rent(n);
+        foreach (var offset in _offsets)
+        {
+            float ox = sx * offset.x, oy = sy * offset.y, oz = sz * offset.z;
+            int m = 0;
+            for (int i = 0; i < n; i++)
+            {
+                float qx = hx[i] - ox, qy = hy[i] - oy, qz = hz[i] - oz;
+                if (!Visits(offset, ix[i], iy[i], iz[i], qx, qy, qz, d[i]))
+                    continue;
+                gx[m] = qx;
+                gy[m] = qy;
+                gz[m] = qz;
+                active[m++] = i;
+            }
+            if (m == 0)
+                continue;
+
+            Evaluator.Evaluate(child, gx[..m], gy[..m], gz[..m], values[..m], scratch);
+            for (int j = 0; j < m; j++)
+                d[active[j]] = MathF.Min(d[active[j]], values[j]);
+        }
+        ArrayPool<int>.Shared.Return(active);
+        scratch.Release(mark);
+    }
+}
@@ -1,5 +1,9 @@
 using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Linq;
 using System.Numerics;
+using System.Threading;
 
 namespace SDF;
 
@@ -8,12 +12,239 @@ namespace SDF;
 /// </summary>
 public class SDF3
 {
-    private readonly Func<Vector3[], double[]> _function;
     internal double? SmoothingK { get; set; }
 
-    public SDF3(Func<Vector3[], double[]> function)
+    /// <summary>
+    /// Kind of node this SDF represents in the expression graph
+    /// </summary>
+    public SdfNodeKind Kind { get; }
+
+    /// <summary>
+    /// Numeric parameters of the node (layout depends on <see cref="Kind"/>)
+    /// </summary>
+    public IReadOnlyList<double> Parameters => Args;
+
+    /// <summary>
+    /// Child nodes this node is computed from
+    /// </summary>
+    public IReadOnlyList<SDF3> Children => Inputs;
+
+    internal double[] Args { get; }
+    internal SDF3[] Inputs { get; }
+    internal Func<Vector3[], double[]>? Function { get; }
+    internal Func<double, double, double, double>? Kernel { get; }
+
+    /// <summary>
+    /// Bounding volume hierarchy over the children of an n-ary union
+    /// </summary>
+    internal UnionBvh? Bvh { get; }
+
+    /// <summary>
+    /// Neighbor cells a padded repeat visits besides each point's own
+    /// </summary>
+    internal RepeatNeighbors? Neighbors { get; }
+
+    /// <summary>
+    /// Grid spacing this subtree is baked at once it is hot, when marked with <see cref="Static"/>
+    /// </summary>
+    internal double? BakeStep { get; private init; }
+
+    private readonly bool _staticInputs;
+    private NodeTier? _tier;
+    private double? _lipschitz;
+    private int? _structuralHash;
+    private byte[]? _contentHash;
+    private HashSet<SDF3>? _sharedNodes;
+    private bool _sharedNodesKnown;
+
+    /// <summary>
+    /// Hash of the subtree's structure, equal for structurally identical subtrees
+    /// </summary>
+    internal int StructuralHash => _structuralHash ??= StructuralComparer.ComputeHash(this);
+
+    /// <summary>
+    /// Stable SHA-256 of the subtree's structure for on-disk caches, or null when
+    /// it has custom leaves
+    /// </summary>
+    internal byte[]? ContentHash => HasCustom ? null : _contentHash ??= BatchCache.ComputeContentHash(this);
+
+    /// <summary>
+    /// Inner nodes of this graph reached through more than one parent, or null when none are
+    /// </summary>
+    internal HashSet<SDF3>? SharedNodes
+    {
+        get
+        {
+            if (!_sharedNodesKnown)
+            {
+                _sharedNodes = HashConsing.FindShared(this);
+                _sharedNodesKnown = true;
+            }
+            return _sharedNodes;
+        }
+    }
+
+    /// <summary>
+    /// True when this node or any descendant is an opaque custom function
+    /// </summary>
+    internal bool HasCustom { get; }
+
+    /// <summary>
+    /// True when this node or any descendant is marked with <see cref="Static"/>
+    /// </summary>
+    internal bool HasStatic => BakeStep != null || _staticInputs;
+
+    /// <summary>
+    /// Whether <see cref="TieredEvaluation"/> can promote this node: static
+    /// subtrees are baked, and inner nodes without custom leaves compiled.
+    /// Subtrees holding static nodes are not compiled, so those still get baked.
+    /// </summary>
+    internal bool Promotable => BakeStep != null || (Inputs.Length > 0 && !HasCustom && !HasStatic);
+
+    /// <summary>
+    /// Points counted and promoted form of this node under <see cref="TieredEvaluation"/>
+    /// </summary>
+    internal NodeTier Tier
+    {
+        get
+        {
+            if (_tier == null)
+                Interlocked.CompareExchange(ref _tier, new NodeTier(), null);
+            return _tier;
+        }
+    }
+
+    /// <summary>
+    /// Create a custom SDF leaf from an opaque function. <paramref name="lipschitz"/>
+    /// bounds how fast the function can change per unit of distance; exact
+    /// distance functions have 1.
+    /// </summary>
+    public SDF3(Func<Vector3[], double[]> function, double lipschitz = 1.0)
+    {
+        if (!(lipschitz > 0))
+            throw new ArgumentOutOfRangeException(nameof(lipschitz), "Lipschitz constant must be positive");
+        Function = function ?? throw new ArgumentNullException(nameof(function));
+        Kind = SdfNodeKind.Custom;
+        Args = new[] { lipschitz };
+        Inputs = Array.Empty<SDF3>();
+        HasCustom = true;
+    }
+
+    internal SDF3(SdfNodeKind kind, double[] args, params SDF3[] inputs)
+    {
+        if (kind == SdfNodeKind.Custom)
+            throw new ArgumentException("Custom nodes require a function", nameof(kind));
+        Kind = kind;
+        Args = args;
+        Inputs = inputs;
+        HasCustom = inputs.Any(c => c.HasCustom);
+        _staticInputs = inputs.Any(c => c.HasStatic);
+        if (kind == SdfNodeKind.NaryUnion)
+            Bvh = new UnionBvh(inputs);
+        if (kind == SdfNodeKind.Repeat && args[6] > 0)
+            Neighbors = new RepeatNeighbors(args, inputs[0]);
+    }
+
+    private SDF3(SDF3 source, Func<double, double, double, double> kernel)
+    {
+        Kind = source.Kind;
+        Args = source.Args;
+        Inputs = source.Inputs;
+        Function = source.Function;
+        HasCustom = source.HasCustom;
+        Bvh = source.Bvh;
+        Neighbors = source.Neighbors;
+        SmoothingK = source.SmoothingK;
+        BakeStep = source.BakeStep;
+        _staticInputs = source._staticInputs;
+        Kernel = kernel;
+    }
+
+    private SDF3(SDF3 source, double bakeStep)
+    {
+        Kind = source.Kind;
+        Args = source.Args;
+        Inputs = source.Inputs;
+        Function = source.Function;
+        HasCustom = source.HasCustom;
+        Bvh = source.Bvh;
+        Neighbors = source.Neighbors;
+        SmoothingK = source.SmoothingK;
+        BakeStep = bakeStep;
+        _staticInputs = source._staticInputs;
+    }
+
+    /// <summary>
+    /// Copy of this node over different children, or this node itself when the
+    /// children are unchanged
+    /// </summary>
+    internal SDF3 WithInputs(params SDF3[] inputs)
+    {
+        bool same = inputs.Length == Inputs.Length;
+        for (int i = 0; same && i < inputs.Length; i++)
+            same &= ReferenceEquals(inputs[i], Inputs[i]);
+        return same ? this : new SDF3(Kind, Args, inputs) { BakeStep = BakeStep };
+    }
+
+    /// <summary>
+    /// Compile the whole tree into a single fused per-point kernel.
+    /// The returned SDF has the same graph (with transform chains folded and
+    /// repeated subtrees shared, see <see cref="FoldTransforms"/> and
+    /// <see cref="Share"/>) but evaluates every point in one pass without
+    /// intermediate arrays. Custom leaves are called one point at a time,
+    /// so trees built from custom functions are better left uncompiled.
+    /// </summary>
+    public SDF3 Compile()
+    {
+        if (Kernel != null || Kind == SdfNodeKind.Custom)
+            return this;
+        var shared = FoldTransforms().Share();
+        return new SDF3(shared, Compiler.Compile(shared));
+    }
+
+    /// <summary>
+    /// Attach a per-point kernel compiled ahead of time, such as one generated
+    /// for an <see cref="SdfSceneAttribute"/> method. The kernel must compute
+    /// this tree's distances; the tree itself is still used for bounds, pruning
+    /// and float evaluation.
+    /// </summary>
+    public SDF3 WithKernel(Func<double, double, double, double> kernel)
+    {
+        ArgumentNullException.ThrowIfNull(kernel);
+        return new SDF3(FoldTransforms().Share(), kernel);
+    }
+
+    /// <summary>
+    /// Compile like <see cref="Compile()"/>, reusing a kernel from
+    /// <paramref name="templates"/> when a tree of the same shape was compiled before
+    /// </summary>
+    internal SDF3 Compile(ConcurrentDictionary<string, Compiler.TemplateKernel> templates)
     {
-        _function = function ?? throw new ArgumentNullException(nameof(function));
+        if (Kernel != null || Kind == SdfNodeKind.Custom)
+            return this;
+        var shared = FoldTransforms().Share();
+        return new SDF3(shared, Compiler.Compile(shared, templates));
+    }
+
+    /// <summary>
+    /// Fold every chain of translations, rotations and uniform scales into a
+    /// single affine node, so each chain maps the points in one pass. Returns
+    /// this SDF itself when there is nothing to fold.
+    /// </summary>
+    public SDF3 FoldTransforms()
+    {
+        return TransformFolding.Fold(this);
+    }
+
+    /// <summary>
+    /// Merge structurally identical subtrees into single instances. The result
+    /// takes the same values, but evaluators compute each repeated subtree once
+    /// per set of points instead of once per occurrence. Returns this SDF itself
+    /// when nothing repeats.
+    /// </summary>
+    public SDF3 Share()
+    {
+        return HashConsing.Share(this);
     }
 
     /// <summary>
@@ -21,9 +252,141 @@ public class SDF3
     /// </summary>
     public double[] Evaluate(Vector3[] points)
     {
-        return _function(points);
+        return Evaluator.Evaluate(this, points);
+    }
+
+    /// <summary>
+    /// Evaluate the SDF at points given as separate X, Y and Z float arrays.
+    /// Primitives and booleans run as SIMD kernels over the float lanes.
+    /// </summary>
+    public float[] Evaluate(float[] x, float[] y, float[] z)
+    {
+        var result = new float[x.Length];
+        Evaluate(x, y, z, result, EvalScratch.Current);
+        return result;
+    }
+
+    /// <summary>
+    /// Evaluate the SDF at points given as separate X, Y and Z lanes, writing
+    /// distances into caller-owned memory. Temporaries are taken from
+    /// <paramref name="scratch"/>, so steady-state evaluation does not allocate
+    /// (custom leaves excepted).
+    /// </summary>
+    public void Evaluate(ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z,
+        Span<float> result, EvalScratch scratch)
+    {
+        if (x.Length != result.Length || y.Length != result.Length || z.Length != result.Length)
+            throw new ArgumentException("Coordinate and result spans must have the same length");
+        ArgumentNullException.ThrowIfNull(scratch);
+
+        var mark = scratch.Mark;
+        try
+        {
+            Evaluator.Evaluate(this, x, y, z, result, scratch);
+        }
+        finally
+        {
+            scratch.Release(mark);
+        }
+    }
+
+    /// <summary>
+    /// Evaluate the SDF and its gradient at given points in a single pass, using
+    /// forward-mode automatic differentiation. Gradients are exact wherever the
+    /// field is differentiable; custom leaves are differentiated by central
+    /// differences.
+    /// </summary>
+    public double[] EvaluateWithGradient(Vector3[] points, out Vector3[] gradients)
+    {
+        var duals = GradientEvaluator.Evaluate(this, points);
+        var values = new double[points.Length];
+        gradients = new Vector3[points.Length];
+        for (int i = 0; i < duals.Length; i++)
+        {
+            values[i] = duals[i].Value;
+            gradients[i] = duals[i].Gradient;
+        }
+        return values;
+    }
+
+    /// <summary>
+    /// Gradient of the SDF at given points (see <see cref="EvaluateWithGradient"/>)
+    /// </summary>
+    public Vector3[] Gradient(Vector3[] points)
+    {
+        EvaluateWithGradient(points, out var gradients);
+        return gradients;
+    }
+
+    /// <summary>
+    /// Unit surface normals at given points: the normalized gradient, or zero
+    /// where the gradient vanishes
+    /// </summary>
+    public Vector3[] Normals(Vector3[] points)
+    {
+        var normals = Gradient(points);
+        for (int i = 0; i < normals.Length; i++)
+            normals[i] = normals[i].Normalize();
+        return normals;
+    }
+
+    /// <summary>
+    /// Conservative range of values this SDF takes inside an axis-aligned box.
+    /// If the range excludes zero the box is guaranteed to hold no surface.
+    /// Custom leaves make the range unbounded.
+    /// </summary>
+    public Interval EvaluateInterval((Vector3 min, Vector3 max) box)
+    {
+        return IntervalEvaluator.Evaluate(this, box);
+    }
+
+    /// <summary>
+    /// Specialize the tree to a box by dropping union and intersection branches
+    /// that cannot affect any value inside it. The result evaluates identically
+    /// within the box and is usually much smaller for large CSG scenes.
+    /// </summary>
+    public SDF3 Prune((Vector3 min, Vector3 max) box)
+    {
+        return IntervalEvaluator.Prune(this, box);
+    }
+
+    /// <summary>
+    /// Axis-aligned box enclosing the solid, computed from the node parameters
+    /// without sampling. Null when the solid is unbounded along some axis or
+    /// contains custom leaves that nothing else bounds.
+    /// </summary>
+    public (Vector3 min, Vector3 max)? Bounds
+    {
+        get
+        {
+            var (x, y, z) = BoundsEvaluator.Evaluate(this);
+            if (!x.IsFinite || !y.IsFinite || !z.IsFinite || BoundsEvaluator.IsEmpty((x, y, z)))
+                return null;
+            return (new Vector3(x.Lo, y.Lo, z.Lo), new Vector3(x.Hi, y.Hi, z.Hi));
+        }
+    }
+
+    /// <summary>
+    /// Bound on how fast the field changes per unit of distance, anywhere in space.
+    /// Twists and bends stretch without limit away from their axis, so this is
+    /// infinite for them; use <see cref="LipschitzBound"/> over a finite region.
+    /// </summary>
+    public double Lipschitz => _lipschitz ??= LipschitzEvaluator.Bound(this, Interval.Entire, Interval.Entire, Interval.Entire);
+
+    /// <summary>
+    /// Bound on how fast the field changes per unit of distance inside a box.
+    /// A sample of value d there proves no surface lies within |d| / L of it.
+    /// </summary>
+    public double LipschitzBound((Vector3 min, Vector3 max) box)
+    {
+        return LipschitzEvaluator.Bound(this, box);
     }
 
+    public override string ToString() =>
+        Inputs.Length == 0 && Args.Length == 0
+            ? Kind.ToString()
+            : $"{Kind}({string.Join(", ", Args.Select(a => a.ToString("G4")).Concat(Inputs.Select(c => c.ToString())))})";
+
     /// <summary>
     /// Set smoothing factor for boolean operations
     /// </summary>
@@ -33,6 +396,22 @@ public class SDF3
         return this;
     }
 
+    /// <summary>
+    /// Mark this subtree as static: once it has handled enough points (see
+    /// <see cref="TieredEvaluation"/>), it is sampled every <paramref name="step"/>
+    /// over its bounds and interpolated from then on. Meshing bakes it before
+    /// sampling instead, so the whole mesh sees one field. Interpolated distances are
+    /// approximate between samples, so pick a step well below the features
+    /// that matter. Subtrees without finite bounds, or needing more than
+    /// <see cref="TieredEvaluation.MaxBakeSamples"/> samples, are never baked.
+    /// </summary>
+    public SDF3 Static(double step)
+    {
+        if (!(step > 0))
+            throw new ArgumentOutOfRangeException(nameof(step), "Bake step must be positive");
+        return new SDF3(this, step);
+    }
+
     /// <summary>
     /// Union operation (OR)
     /// </summary>
@@ -60,13 +439,36 @@ public class SDF3
         int samples = 1 << 22,
         int batchSize = 32,
         bool sparse = true,
-        bool verbose = true)
+        bool verbose = true,
+        MeshPrecision precision = MeshPrecision.Double,
+        Profiler? profiler = null,
+        BatchCache? cache = null,
+        MeshMethod method = MeshMethod.MarchingCubes)
     {
-        return Core.Generate(this, step, bounds, samples, batchSize, sparse, verbose);
+        return Core.Generate(this, step, bounds, samples, batchSize, sparse, verbose, precision, profiler, cache, method);
     }
 
     /// <summary>
-    /// Save mesh to STL file
+    /// Generate indexed mesh from this SDF, with every vertex stored once
+    /// </summary>
+    public IndexedMesh GenerateIndexed(
+        double? step = null,
+        (Vector3 min, Vector3 max)? bounds = null,
+        int samples = 1 << 22,
+        int batchSize = 32,
+        bool sparse = true,
+        bool verbose = true,
+        MeshPrecision precision = MeshPrecision.Double,
+        Profiler? profiler = null,
+        BatchCache? cache = null,
+        MeshMethod method = MeshMethod.MarchingCubes)
+    {
+        return Core.GenerateIndexed(this, step, bounds, samples, batchSize, sparse, verbose, precision, profiler, cache, method);
+    }
+
+    /// <summary>
+    /// Save mesh to STL file, or to binary PLY with shared vertices when the
+    /// path ends in .ply
     /// </summary>
     public void Save(
         string path,
@@ -75,9 +477,19 @@ public class SDF3
         int samples = 1 << 22,
         int batchSize = 32,
         bool sparse = true,
-        bool verbose = true)
+        bool verbose = true,
+        MeshPrecision precision = MeshPrecision.Double,
+        Profiler? profiler = null,
+        BatchCache? cache = null,
+        MeshMethod method = MeshMethod.MarchingCubes)
     {
-        var points = Generate(step, bounds, samples, batchSize, sparse, verbose);
+        if (path.EndsWith(".ply", StringComparison.OrdinalIgnoreCase))
+        {
+            PlyWriter.WriteBinaryPly(path, GenerateIndexed(step, bounds, samples, batchSize, sparse, verbose, precision, profiler, cache, method));
+            return;
+        }
+
+        var points = Generate(step, bounds, samples, batchSize, sparse, verbose, precision, profiler, cache, method);
         StlWriter.WriteBinaryStl(path, points);
     }
 }
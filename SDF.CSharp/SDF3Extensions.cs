@@ -19,7 +19,46 @@ public static class SDF3Extensions
         int? workers = null,
         int? batchSize = null,
         bool? verbose = null,
-        bool? sparse = null)
+        bool? sparse = null,
+        MeshPrecision? precision = null,
+        Profiler? profiler = null,
+        BatchCache? cache = null,
+        MeshMethod? method = null)
+    {
+        var generator = CreateGenerator(samples, workers, batchSize, verbose, sparse, precision, profiler, cache, method);
+        return generator.Generate(sdf, step, bounds);
+    }
+
+    /// <summary>
+    /// Generate an indexed mesh from this SDF, with every vertex stored once
+    /// </summary>
+    public static IndexedMesh GenerateIndexed(this SDF3 sdf,
+        double? step = null,
+        (Vector3, Vector3)? bounds = null,
+        int? samples = null,
+        int? workers = null,
+        int? batchSize = null,
+        bool? verbose = null,
+        bool? sparse = null,
+        MeshPrecision? precision = null,
+        Profiler? profiler = null,
+        BatchCache? cache = null,
+        MeshMethod? method = null)
+    {
+        var generator = CreateGenerator(samples, workers, batchSize, verbose, sparse, precision, profiler, cache, method);
+        return generator.GenerateIndexed(sdf, step, bounds);
+    }
+
+    private static MeshGenerator CreateGenerator(
+        int? samples,
+        int? workers,
+        int? batchSize,
+        bool? verbose,
+        bool? sparse,
+        MeshPrecision? precision,
+        Profiler? profiler,
+        BatchCache? cache,
+        MeshMethod? method)
     {
         var generator = new MeshGenerator();
         
@@ -28,12 +67,17 @@ public static class SDF3Extensions
         if (batchSize.HasValue) generator.BatchSize = batchSize.Value;
         if (verbose.HasValue) generator.Verbose = verbose.Value;
         if (sparse.HasValue) generator.Sparse = sparse.Value;
+        if (precision.HasValue) generator.Precision = precision.Value;
+        if (method.HasValue) generator.Method = method.Value;
+        generator.Profiler = profiler;
+        generator.Cache = cache;
         
-        return generator.Generate(sdf, step, bounds);
+        return generator;
     }
 
     /// <summary>
-    /// Save this SDF as an STL file
+    /// Save this SDF as an STL file, or as a binary PLY file with shared
+    /// vertices when the path ends in .ply
     /// </summary>
     public static void Save(this SDF3 sdf, string path,
         double? step = null,
@@ -42,10 +86,22 @@ public static class SDF3Extensions
         int? workers = null,
         int? batchSize = null,
         bool? verbose = null,
-        bool? sparse = null)
+        bool? sparse = null,
+        MeshPrecision? precision = null,
+        Profiler? profiler = null,
+        BatchCache? cache = null,
+        MeshMethod? method = null)
     {
-        var triangles = sdf.Generate(step, bounds, samples, workers, batchSize, verbose, sparse);
-        StlWriter.WriteBinaryStl(path, triangles);
+        if (path.EndsWith(".ply", StringComparison.OrdinalIgnoreCase))
+        {
+            var mesh = sdf.GenerateIndexed(step, bounds, samples, workers, batchSize, verbose, sparse, precision, profiler, cache, method);
+            PlyWriter.WriteBinaryPly(path, mesh);
+        }
+        else
+        {
+            var triangles = sdf.Generate(step, bounds, samples, workers, batchSize, verbose, sparse, precision, profiler, cache, method);
+            StlWriter.WriteBinaryStl(path, triangles);
+        }
         
         if (verbose ?? true)
         {
@@ -0,0 +1,84 @@
+namespace SDF;
+
+/// <summary>
+/// Kind of node in an SDF3 expression graph.
+/// The comment on each member lists the layout of <see cref="SDF3.Parameters"/>
+/// and the children the node expects.
+/// </summary>
+public enum SdfNodeKind
+{
+    /// <summary>Opaque user function [lipschitz] - declared bound on its gradient magnitude</summary>
+    Custom,
+
+    // Primitives (leaves)
+
+    /// <summary>[radius, cx, cy, cz]</summary>
+    Sphere,
+    /// <summary>[sx, sy, sz, cx, cy, cz] - full edge lengths</summary>
+    Box,
+    /// <summary>[radius] - infinite along Z</summary>
+    Cylinder,
+    /// <summary>[ax, ay, az, bx, by, bz, radius]</summary>
+    CappedCylinder,
+    /// <summary>[nx, ny, nz, px, py, pz] - normal is unit length</summary>
+    Plane,
+    /// <summary>[r1, r2]</summary>
+    Torus,
+    /// <summary>[sx, sy, sz, radius]</summary>
+    RoundedBox,
+    /// <summary>[ax, ay, az, bx, by, bz, radius]</summary>
+    Capsule,
+    /// <summary>[sx, sy, sz]</summary>
+    Ellipsoid,
+
+    // Booleans (two children: a, b)
+
+    /// <summary>[] - min(a, b)</summary>
+    Union,
+    /// <summary>[] - max(a, b)</summary>
+    Intersection,
+    /// <summary>[] - max(a, -b)</summary>
+    Difference,
+    /// <summary>[k]</summary>
+    SmoothUnion,
+    /// <summary>[k]</summary>
+    SmoothIntersection,
+    /// <summary>[k]</summary>
+    SmoothDifference,
+    /// <summary>[k] - any number of children; min of all, or with k &gt; 0 a smooth blend of the two closest</summary>
+    NaryUnion,
+
+    // Domain transforms (one child)
+
+    /// <summary>[ox, oy, oz]</summary>
+    Translate,
+    /// <summary>[factor]</summary>
+    Scale,
+    /// <summary>[angle, ax, ay, az] - axis is unit length</summary>
+    Rotate,
+    /// <summary>[k]</summary>
+    Twist,
+    /// <summary>[k]</summary>
+    Bend,
+    /// <summary>[sx, sy, sz]</summary>
+    Elongate,
+    /// <summary>
+    /// [spx, spy, spz, cx, cy, cz, padding] - counts are +inf when unbounded; padding is
+    /// how many neighboring cells along each repeated axis may also reach a point
+    /// </summary>
+    Repeat,
+    /// <summary>
+    /// [m00, m01, m02, m10, m11, m12, m20, m21, m22, tx, ty, tz, s] - child sees M * p + t
+    /// and its distance is multiplied by s; M is a rotation divided by s
+    /// </summary>
+    Affine,
+
+    // Distance modifiers (one child)
+
+    /// <summary>[r]</summary>
+    Dilate,
+    /// <summary>[r]</summary>
+    Erode,
+    /// <summary>[thickness]</summary>
+    Shell,
+}
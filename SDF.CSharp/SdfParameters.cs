@@ -0,0 +1,31 @@
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Values of a template's named parameters, passed to its builder
+/// </summary>
+public sealed class SdfParameters
+{
+    private readonly Dictionary<string, int> _index;
+    private readonly double[] _values;
+
+    internal SdfParameters(Dictionary<string, int> index, double[] values)
+    {
+        _index = index;
+        _values = values;
+    }
+
+    /// <summary>
+    /// Value of the parameter called <paramref name="name"/>
+    /// </summary>
+    public double this[string name] =>
+        _index.TryGetValue(name, out var i)
+            ? _values[i]
+            : throw new KeyNotFoundException($"Template has no parameter '{name}'");
+
+    /// <summary>
+    /// Value of the parameter at <paramref name="index"/> in declaration order
+    /// </summary>
+    public double this[int index] => _values[index];
+}
@@ -0,0 +1,15 @@
+using System;
+
+namespace SDF;
+
+/// <summary>
+/// Marks a static, parameterless method returning an <see cref="SDF3"/> whose
+/// tree is fixed at build time. With the SDF.Generators source generator
+/// referenced as an analyzer, the method's partial type gains
+/// <c>{Name}Kernel(x, y, z)</c>, a distance function specialized to the tree,
+/// and <c>{Name}Compiled()</c>, the scene with that kernel attached.
+/// </summary>
+[AttributeUsage(AttributeTargets.Method, Inherited = false)]
+public sealed class SdfSceneAttribute : Attribute
+{
+}
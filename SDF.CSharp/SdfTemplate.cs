@@ -0,0 +1,107 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// A part built from named parameters, such as a box size or a hole radius.
+/// Each call to <see cref="Bind(double[])"/> runs the builder for one set of
+/// values, which only allocates the node graph, and compiles the result
+/// against the kernels of earlier variants: trees that differ only in their
+/// numbers share one compiled kernel and read their own constants from an
+/// array, so generating thousands of variants compiles once per distinct shape.
+/// </summary>
+/// <remarks>
+/// A variant whose parameters change the structure of the tree (a count that
+/// adds children, a zero that drops a branch, or equal sizes that let two
+/// subtrees merge) compiles a kernel of its own, which later variants of that
+/// shape reuse in turn.
+/// </remarks>
+/// <example>
+/// <code>
+/// var part = new SdfTemplate(p =>
+///     Box(new Vector3(p["width"], p["depth"], p["height"])) - Cylinder(p["hole"]),
+///     ("width", 40), ("depth", 20), ("height", 10), ("hole", 3));
+/// foreach (var (width, hole) in skus)
+///     part.Bind(new Dictionary&lt;string, double&gt; { ["width"] = width, ["hole"] = hole })
+///         .Save($"part-{width}-{hole}.stl", step: 0.25);
+/// </code>
+/// </example>
+public sealed class SdfTemplate
+{
+    private readonly Func<SdfParameters, SDF3> _build;
+    private readonly string[] _names;
+    private readonly double[] _defaults;
+    private readonly Dictionary<string, int> _index = new();
+    private readonly ConcurrentDictionary<string, Compiler.TemplateKernel> _kernels = new();
+
+    /// <summary>
+    /// Create a template from a builder and its parameters with their default values
+    /// </summary>
+    public SdfTemplate(Func<SdfParameters, SDF3> build, params (string name, double value)[] parameters)
+    {
+        _build = build ?? throw new ArgumentNullException(nameof(build));
+        _names = new string[parameters.Length];
+        _defaults = new double[parameters.Length];
+        for (int i = 0; i < parameters.Length; i++)
+        {
+            var (name, value) = parameters[i];
+            if (!_index.TryAdd(name, i))
+                throw new ArgumentException($"Parameter '{name}' is declared twice", nameof(parameters));
+            _names[i] = name;
+            _defaults[i] = value;
+        }
+    }
+
+    /// <summary>
+    /// Parameter names in declaration order, which is the order of positional values
+    /// </summary>
+    public IReadOnlyList<string> Names => _names;
+
+    /// <summary>
+    /// Default value of each parameter, in declaration order
+    /// </summary>
+    public IReadOnlyList<double> Defaults => _defaults;
+
+    /// <summary>
+    /// Kernels compiled so far: one per distinct shape of the variants bound,
+    /// plus one per shape of the subtrees compiled on their own (union
+    /// children and padded repeats)
+    /// </summary>
+    public int KernelCount => _kernels.Count;
+
+    /// <summary>
+    /// Build and compile the variant with every parameter at its default
+    /// </summary>
+    public SDF3 Bind() => Bind(_defaults);
+
+    /// <summary>
+    /// Build and compile the variant with one value per parameter, in declaration order
+    /// </summary>
+    public SDF3 Bind(params double[] values)
+    {
+        if (values.Length != _names.Length)
+            throw new ArgumentException($"Expected {_names.Length} parameter values, got {values.Length}", nameof(values));
+
+        var sdf = _build(new SdfParameters(_index, (double[])values.Clone()))
+            ?? throw new InvalidOperationException("Template builder returned null");
+        return sdf.HasCustom ? sdf : sdf.Compile(_kernels);
+    }
+
+    /// <summary>
+    /// Build and compile the variant with the given values, leaving every
+    /// parameter not named at its default
+    /// </summary>
+    public SDF3 Bind(IReadOnlyDictionary<string, double> values)
+    {
+        var vector = (double[])_defaults.Clone();
+        foreach (var (name, value) in values)
+        {
+            if (!_index.TryGetValue(name, out var i))
+                throw new ArgumentException($"Template has no parameter '{name}'", nameof(values));
+            vector[i] = value;
+        }
+        return Bind(vector);
+    }
+}
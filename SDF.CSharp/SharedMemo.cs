@@ -0,0 +1,35 @@
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Results of shared subtrees computed during one pass over a hash-consed graph,
+/// keyed by the node together with whatever identifies the inputs it was
+/// computed for. Only nodes reached through more than one parent are stored.
+/// </summary>
+internal sealed class SharedMemo<TKey, TValue> where TKey : notnull
+{
+    private readonly HashSet<SDF3> _shared;
+    private int _domains;
+
+    private SharedMemo(HashSet<SDF3> shared)
+    {
+        _shared = shared;
+    }
+
+    public Dictionary<TKey, TValue> Values { get; } = new();
+
+    /// <summary>
+    /// Memo for a pass starting at <paramref name="root"/>, or null when no node
+    /// of its graph is shared
+    /// </summary>
+    public static SharedMemo<TKey, TValue>? For(SDF3 root) =>
+        root.SharedNodes is { } shared ? new SharedMemo<TKey, TValue>(shared) : null;
+
+    public bool IsShared(SDF3 node) => _shared.Contains(node);
+
+    /// <summary>
+    /// Fresh id for a set of points derived from others, such as the output of a transform
+    /// </summary>
+    public int NewDomain() => ++_domains;
+}
@@ -0,0 +1,573 @@
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+
+namespace SDF;
+
+/// <summary>
+/// SIMD evaluation kernels over structure-of-arrays float lanes.
+/// Each kernel uses Vector512 or Vector256 when the hardware accelerates it
+/// and finishes the remaining points (or everything, on older hardware) with
+/// a scalar loop.
+/// </summary>
+internal static class SimdKernels
+{
+    /// <summary>
+    /// Number of float lanes processed per iteration on this machine
+    /// </summary>
+    public static int Width =>
+        Vector512.IsHardwareAccelerated ? Vector512<float>.Count :
+        Vector256.IsHardwareAccelerated ? Vector256<float>.Count : 1;
+
+    // Primitives
+
+    public static void Sphere(ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        float radius, float cx, float cy, float cz)
+    {
+        int i = 0, n = d.Length;
+        ref var xr = ref MemoryMarshal.GetReference(x);
+        ref var yr = ref MemoryMarshal.GetReference(y);
+        ref var zr = ref MemoryMarshal.GetReference(z);
+        ref var dr = ref MemoryMarshal.GetReference(d);
+
+        if (Vector512.IsHardwareAccelerated)
+        {
+            var vr = Vector512.Create(radius);
+            var vcx = Vector512.Create(cx);
+            var vcy = Vector512.Create(cy);
+            var vcz = Vector512.Create(cz);
+            for (; i <= n - Vector512<float>.Count; i += Vector512<float>.Count)
+            {
+                var dx = Vector512.LoadUnsafe(ref xr, (nuint)i) - vcx;
+                var dy = Vector512.LoadUnsafe(ref yr, (nuint)i) - vcy;
+                var dz = Vector512.LoadUnsafe(ref zr, (nuint)i) - vcz;
+                (Vector512.Sqrt(dx * dx + dy * dy + dz * dz) - vr).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+        else if (Vector256.IsHardwareAccelerated)
+        {
+            var vr = Vector256.Create(radius);
+            var vcx = Vector256.Create(cx);
+            var vcy = Vector256.Create(cy);
+            var vcz = Vector256.Create(cz);
+            for (; i <= n - Vector256<float>.Count; i += Vector256<float>.Count)
+            {
+                var dx = Vector256.LoadUnsafe(ref xr, (nuint)i) - vcx;
+                var dy = Vector256.LoadUnsafe(ref yr, (nuint)i) - vcy;
+                var dz = Vector256.LoadUnsafe(ref zr, (nuint)i) - vcz;
+                (Vector256.Sqrt(dx * dx + dy * dy + dz * dz) - vr).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+
+        for (; i < n; i++)
+        {
+            var dx = x[i] - cx;
+            var dy = y[i] - cy;
+            var dz = z[i] - cz;
+            d[i] = MathF.Sqrt(dx * dx + dy * dy + dz * dz) - radius;
+        }
+    }
+
+    public static void Box(ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        float hx, float hy, float hz, float cx, float cy, float cz)
+    {
+        int i = 0, n = d.Length;
+        ref var xr = ref MemoryMarshal.GetReference(x);
+        ref var yr = ref MemoryMarshal.GetReference(y);
+        ref var zr = ref MemoryMarshal.GetReference(z);
+        ref var dr = ref MemoryMarshal.GetReference(d);
+
+        if (Vector512.IsHardwareAccelerated)
+        {
+            var zero = Vector512<float>.Zero;
+            var vhx = Vector512.Create(hx);
+            var vhy = Vector512.Create(hy);
+            var vhz = Vector512.Create(hz);
+            var vcx = Vector512.Create(cx);
+            var vcy = Vector512.Create(cy);
+            var vcz = Vector512.Create(cz);
+            for (; i <= n - Vector512<float>.Count; i += Vector512<float>.Count)
+            {
+                var qx = Vector512.Abs(Vector512.LoadUnsafe(ref xr, (nuint)i) - vcx) - vhx;
+                var qy = Vector512.Abs(Vector512.LoadUnsafe(ref yr, (nuint)i) - vcy) - vhy;
+                var qz = Vector512.Abs(Vector512.LoadUnsafe(ref zr, (nuint)i) - vcz) - vhz;
+                var ox = Vector512.Max(qx, zero);
+                var oy = Vector512.Max(qy, zero);
+                var oz = Vector512.Max(qz, zero);
+                var inside = Vector512.Min(Vector512.Max(qx, Vector512.Max(qy, qz)), zero);
+                (Vector512.Sqrt(ox * ox + oy * oy + oz * oz) + inside).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+        else if (Vector256.IsHardwareAccelerated)
+        {
+            var zero = Vector256<float>.Zero;
+            var vhx = Vector256.Create(hx);
+            var vhy = Vector256.Create(hy);
+            var vhz = Vector256.Create(hz);
+            var vcx = Vector256.Create(cx);
+            var vcy = Vector256.Create(cy);
+            var vcz = Vector256.Create(cz);
+            for (; i <= n - Vector256<float>.Count; i += Vector256<float>.Count)
+            {
+                var qx = Vector256.Abs(Vector256.LoadUnsafe(ref xr, (nuint)i) - vcx) - vhx;
+                var qy = Vector256.Abs(Vector256.LoadUnsafe(ref yr, (nuint)i) - vcy) - vhy;
+                var qz = Vector256.Abs(Vector256.LoadUnsafe(ref zr, (nuint)i) - vcz) - vhz;
+                var ox = Vector256.Max(qx, zero);
+                var oy = Vector256.Max(qy, zero);
+                var oz = Vector256.Max(qz, zero);
+                var inside = Vector256.Min(Vector256.Max(qx, Vector256.Max(qy, qz)), zero);
+                (Vector256.Sqrt(ox * ox + oy * oy + oz * oz) + inside).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+
+        for (; i < n; i++)
+        {
+            var qx = MathF.Abs(x[i] - cx) - hx;
+            var qy = MathF.Abs(y[i] - cy) - hy;
+            var qz = MathF.Abs(z[i] - cz) - hz;
+            var ox = MathF.Max(qx, 0);
+            var oy = MathF.Max(qy, 0);
+            var oz = MathF.Max(qz, 0);
+            var inside = MathF.Min(MathF.Max(qx, MathF.Max(qy, qz)), 0);
+            d[i] = MathF.Sqrt(ox * ox + oy * oy + oz * oz) + inside;
+        }
+    }
+
+    public static void Torus(ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        float r1, float r2)
+    {
+        int i = 0, n = d.Length;
+        ref var xr = ref MemoryMarshal.GetReference(x);
+        ref var yr = ref MemoryMarshal.GetReference(y);
+        ref var zr = ref MemoryMarshal.GetReference(z);
+        ref var dr = ref MemoryMarshal.GetReference(d);
+
+        if (Vector512.IsHardwareAccelerated)
+        {
+            var vr1 = Vector512.Create(r1);
+            var vr2 = Vector512.Create(r2);
+            for (; i <= n - Vector512<float>.Count; i += Vector512<float>.Count)
+            {
+                var px = Vector512.LoadUnsafe(ref xr, (nuint)i);
+                var py = Vector512.LoadUnsafe(ref yr, (nuint)i);
+                var pz = Vector512.LoadUnsafe(ref zr, (nuint)i);
+                var qx = Vector512.Sqrt(px * px + py * py) - vr1;
+                (Vector512.Sqrt(qx * qx + pz * pz) - vr2).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+        else if (Vector256.IsHardwareAccelerated)
+        {
+            var vr1 = Vector256.Create(r1);
+            var vr2 = Vector256.Create(r2);
+            for (; i <= n - Vector256<float>.Count; i += Vector256<float>.Count)
+            {
+                var px = Vector256.LoadUnsafe(ref xr, (nuint)i);
+                var py = Vector256.LoadUnsafe(ref yr, (nuint)i);
+                var pz = Vector256.LoadUnsafe(ref zr, (nuint)i);
+                var qx = Vector256.Sqrt(px * px + py * py) - vr1;
+                (Vector256.Sqrt(qx * qx + pz * pz) - vr2).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+
+        for (; i < n; i++)
+        {
+            var qx = MathF.Sqrt(x[i] * x[i] + y[i] * y[i]) - r1;
+            d[i] = MathF.Sqrt(qx * qx + z[i] * z[i]) - r2;
+        }
+    }
+
+    public static void Capsule(ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        float ax, float ay, float az, float bx, float by, float bz, float radius)
+    {
+        int i = 0, n = d.Length;
+        ref var xr = ref MemoryMarshal.GetReference(x);
+        ref var yr = ref MemoryMarshal.GetReference(y);
+        ref var zr = ref MemoryMarshal.GetReference(z);
+        ref var dr = ref MemoryMarshal.GetReference(d);
+        float bax = bx - ax, bay = by - ay, baz = bz - az;
+        float invBaba = 1f / (bax * bax + bay * bay + baz * baz);
+
+        if (Vector512.IsHardwareAccelerated)
+        {
+            var zero = Vector512<float>.Zero;
+            var one = Vector512<float>.One;
+            var vax = Vector512.Create(ax);
+            var vay = Vector512.Create(ay);
+            var vaz = Vector512.Create(az);
+            var vbax = Vector512.Create(bax);
+            var vbay = Vector512.Create(bay);
+            var vbaz = Vector512.Create(baz);
+            var vinv = Vector512.Create(invBaba);
+            var vr = Vector512.Create(radius);
+            for (; i <= n - Vector512<float>.Count; i += Vector512<float>.Count)
+            {
+                var pax = Vector512.LoadUnsafe(ref xr, (nuint)i) - vax;
+                var pay = Vector512.LoadUnsafe(ref yr, (nuint)i) - vay;
+                var paz = Vector512.LoadUnsafe(ref zr, (nuint)i) - vaz;
+                var h = Vector512.Min(Vector512.Max((pax * vbax + pay * vbay + paz * vbaz) * vinv, zero), one);
+                var dx = pax - vbax * h;
+                var dy = pay - vbay * h;
+                var dz = paz - vbaz * h;
+                (Vector512.Sqrt(dx * dx + dy * dy + dz * dz) - vr).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+        else if (Vector256.IsHardwareAccelerated)
+        {
+            var zero = Vector256<float>.Zero;
+            var one = Vector256<float>.One;
+            var vax = Vector256.Create(ax);
+            var vay = Vector256.Create(ay);
+            var vaz = Vector256.Create(az);
+            var vbax = Vector256.Create(bax);
+            var vbay = Vector256.Create(bay);
+            var vbaz = Vector256.Create(baz);
+            var vinv = Vector256.Create(invBaba);
+            var vr = Vector256.Create(radius);
+            for (; i <= n - Vector256<float>.Count; i += Vector256<float>.Count)
+            {
+                var pax = Vector256.LoadUnsafe(ref xr, (nuint)i) - vax;
+                var pay = Vector256.LoadUnsafe(ref yr, (nuint)i) - vay;
+                var paz = Vector256.LoadUnsafe(ref zr, (nuint)i) - vaz;
+                var h = Vector256.Min(Vector256.Max((pax * vbax + pay * vbay + paz * vbaz) * vinv, zero), one);
+                var dx = pax - vbax * h;
+                var dy = pay - vbay * h;
+                var dz = paz - vbaz * h;
+                (Vector256.Sqrt(dx * dx + dy * dy + dz * dz) - vr).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+
+        for (; i < n; i++)
+        {
+            var pax = x[i] - ax;
+            var pay = y[i] - ay;
+            var paz = z[i] - az;
+            var h = Math.Clamp((pax * bax + pay * bay + paz * baz) * invBaba, 0f, 1f);
+            var dx = pax - bax * h;
+            var dy = pay - bay * h;
+            var dz = paz - baz * h;
+            d[i] = MathF.Sqrt(dx * dx + dy * dy + dz * dz) - radius;
+        }
+    }
+
+    public static void CappedCylinder(ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z, Span<float> d,
+        float ax, float ay, float az, float bx, float by, float bz, float radius)
+    {
+        int i = 0, n = d.Length;
+        ref var xr = ref MemoryMarshal.GetReference(x);
+        ref var yr = ref MemoryMarshal.GetReference(y);
+        ref var zr = ref MemoryMarshal.GetReference(z);
+        ref var dr = ref MemoryMarshal.GetReference(d);
+        float bax = bx - ax, bay = by - ay, baz = bz - az;
+        float baba = bax * bax + bay * bay + baz * baz;
+
+        if (Vector512.IsHardwareAccelerated)
+        {
+            var zero = Vector512<float>.Zero;
+            var vax = Vector512.Create(ax);
+            var vay = Vector512.Create(ay);
+            var vaz = Vector512.Create(az);
+            var vbax = Vector512.Create(bax);
+            var vbay = Vector512.Create(bay);
+            var vbaz = Vector512.Create(baz);
+            var vbaba = Vector512.Create(baba);
+            var vhalf = Vector512.Create(baba * 0.5f);
+            var vrb = Vector512.Create(radius * baba);
+            var vinv = Vector512.Create(1f / baba);
+            for (; i <= n - Vector512<float>.Count; i += Vector512<float>.Count)
+            {
+                var pax = Vector512.LoadUnsafe(ref xr, (nuint)i) - vax;
+                var pay = Vector512.LoadUnsafe(ref yr, (nuint)i) - vay;
+                var paz = Vector512.LoadUnsafe(ref zr, (nuint)i) - vaz;
+                var paba = pax * vbax + pay * vbay + paz * vbaz;
+                var cx = pax * vbaba - vbax * paba;
+                var cy = pay * vbaba - vbay * paba;
+                var cz = paz * vbaba - vbaz * paba;
+                var qx = Vector512.Sqrt(cx * cx + cy * cy + cz * cz) - vrb;
+                var qy = Vector512.Abs(paba - vhalf) - vhalf;
+                var x2 = qx * qx;
+                var y2 = qy * qy * vbaba;
+                var outer = Vector512.ConditionalSelect(Vector512.GreaterThan(qx, zero), x2, zero)
+                          + Vector512.ConditionalSelect(Vector512.GreaterThan(qy, zero), y2, zero);
+                var dd = Vector512.ConditionalSelect(Vector512.LessThan(Vector512.Max(qx, qy), zero), -Vector512.Min(x2, y2), outer);
+                var s = Vector512.Sqrt(Vector512.Abs(dd)) * vinv;
+                Vector512.ConditionalSelect(Vector512.LessThan(dd, zero), -s, s).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+        else if (Vector256.IsHardwareAccelerated)
+        {
+            var zero = Vector256<float>.Zero;
+            var vax = Vector256.Create(ax);
+            var vay = Vector256.Create(ay);
+            var vaz = Vector256.Create(az);
+            var vbax = Vector256.Create(bax);
+            var vbay = Vector256.Create(bay);
+            var vbaz = Vector256.Create(baz);
+            var vbaba = Vector256.Create(baba);
+            var vhalf = Vector256.Create(baba * 0.5f);
+            var vrb = Vector256.Create(radius * baba);
+            var vinv = Vector256.Create(1f / baba);
+            for (; i <= n - Vector256<float>.Count; i += Vector256<float>.Count)
+            {
+                var pax = Vector256.LoadUnsafe(ref xr, (nuint)i) - vax;
+                var pay = Vector256.LoadUnsafe(ref yr, (nuint)i) - vay;
+                var paz = Vector256.LoadUnsafe(ref zr, (nuint)i) - vaz;
+                var paba = pax * vbax + pay * vbay + paz * vbaz;
+                var cx = pax * vbaba - vbax * paba;
+                var cy = pay * vbaba - vbay * paba;
+                var cz = paz * vbaba - vbaz * paba;
+                var qx = Vector256.Sqrt(cx * cx + cy * cy + cz * cz) - vrb;
+                var qy = Vector256.Abs(paba - vhalf) - vhalf;
+                var x2 = qx * qx;
+                var y2 = qy * qy * vbaba;
+                var outer = Vector256.ConditionalSelect(Vector256.GreaterThan(qx, zero), x2, zero)
+                          + Vector256.ConditionalSelect(Vector256.GreaterThan(qy, zero), y2, zero);
+                var dd = Vector256.ConditionalSelect(Vector256.LessThan(Vector256.Max(qx, qy), zero), -Vector256.Min(x2, y2), outer);
+                var s = Vector256.Sqrt(Vector256.Abs(dd)) * vinv;
+                Vector256.ConditionalSelect(Vector256.LessThan(dd, zero), -s, s).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+
+        for (; i < n; i++)
+        {
+            var pax = x[i] - ax;
+            var pay = y[i] - ay;
+            var paz = z[i] - az;
+            var paba = pax * bax + pay * bay + paz * baz;
+            var cx = pax * baba - bax * paba;
+            var cy = pay * baba - bay * paba;
+            var cz = paz * baba - baz * paba;
+            var qx = MathF.Sqrt(cx * cx + cy * cy + cz * cz) - radius * baba;
+            var qy = MathF.Abs(paba - baba * 0.5f) - baba * 0.5f;
+            var x2 = qx * qx;
+            var y2 = qy * qy * baba;
+            var dd = MathF.Max(qx, qy) < 0 ? -MathF.Min(x2, y2) : (qx > 0 ? x2 : 0) + (qy > 0 ? y2 : 0);
+            d[i] = MathF.Sign(dd) * MathF.Sqrt(MathF.Abs(dd)) / baba;
+        }
+    }
+
+    // Booleans
+
+    /// <summary>
+    /// Combine two distance spans in place (result is written to <paramref name="a"/>)
+    /// </summary>
+    public static void Combine(SdfNodeKind kind, float k, Span<float> a, ReadOnlySpan<float> b)
+    {
+        int i = 0, n = a.Length;
+        ref var ar = ref MemoryMarshal.GetReference(a);
+        ref var br = ref MemoryMarshal.GetReference(b);
+
+        if (Vector512.IsHardwareAccelerated)
+        {
+            var vk = Vector512.Create(k);
+            var vq = Vector512.Create(k * 0.25f);
+            var vinv = Vector512.Create(k > 0 ? 1f / k : 0f);
+            for (; i <= n - Vector512<float>.Count; i += Vector512<float>.Count)
+            {
+                var va = Vector512.LoadUnsafe(ref ar, (nuint)i);
+                var vb = Vector512.LoadUnsafe(ref br, (nuint)i);
+                Combine512(kind, va, vb, vk, vq, vinv).StoreUnsafe(ref ar, (nuint)i);
+            }
+        }
+        else if (Vector256.IsHardwareAccelerated)
+        {
+            var vk = Vector256.Create(k);
+            var vq = Vector256.Create(k * 0.25f);
+            var vinv = Vector256.Create(k > 0 ? 1f / k : 0f);
+            for (; i <= n - Vector256<float>.Count; i += Vector256<float>.Count)
+            {
+                var va = Vector256.LoadUnsafe(ref ar, (nuint)i);
+                var vb = Vector256.LoadUnsafe(ref br, (nuint)i);
+                Combine256(kind, va, vb, vk, vq, vinv).StoreUnsafe(ref ar, (nuint)i);
+            }
+        }
+
+        for (; i < n; i++)
+        {
+            a[i] = Combine(kind, k, a[i], b[i]);
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector512<float> Combine512(SdfNodeKind kind, Vector512<float> a, Vector512<float> b,
+        Vector512<float> k, Vector512<float> quarterK, Vector512<float> invK)
+    {
+        switch (kind)
+        {
+            case SdfNodeKind.Union:
+                return Vector512.Min(a, b);
+            case SdfNodeKind.Intersection:
+                return Vector512.Max(a, b);
+            case SdfNodeKind.Difference:
+                return Vector512.Max(a, -b);
+            case SdfNodeKind.SmoothUnion:
+            {
+                var h = Vector512.Max(k - Vector512.Abs(a - b), Vector512<float>.Zero) * invK;
+                return Vector512.Min(a, b) - h * h * quarterK;
+            }
+            case SdfNodeKind.SmoothIntersection:
+            {
+                var h = Vector512.Max(k - Vector512.Abs(a - b), Vector512<float>.Zero) * invK;
+                return Vector512.Max(a, b) + h * h * quarterK;
+            }
+            default:
+            {
+                var nb = -b;
+                var h = Vector512.Max(k - Vector512.Abs(nb - a), Vector512<float>.Zero) * invK;
+                return Vector512.Max(nb, a) + h * h * quarterK;
+            }
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector256<float> Combine256(SdfNodeKind kind, Vector256<float> a, Vector256<float> b,
+        Vector256<float> k, Vector256<float> quarterK, Vector256<float> invK)
+    {
+        switch (kind)
+        {
+            case SdfNodeKind.Union:
+                return Vector256.Min(a, b);
+            case SdfNodeKind.Intersection:
+                return Vector256.Max(a, b);
+            case SdfNodeKind.Difference:
+                return Vector256.Max(a, -b);
+            case SdfNodeKind.SmoothUnion:
+            {
+                var h = Vector256.Max(k - Vector256.Abs(a - b), Vector256<float>.Zero) * invK;
+                return Vector256.Min(a, b) - h * h * quarterK;
+            }
+            case SdfNodeKind.SmoothIntersection:
+            {
+                var h = Vector256.Max(k - Vector256.Abs(a - b), Vector256<float>.Zero) * invK;
+                return Vector256.Max(a, b) + h * h * quarterK;
+            }
+            default:
+            {
+                var nb = -b;
+                var h = Vector256.Max(k - Vector256.Abs(nb - a), Vector256<float>.Zero) * invK;
+                return Vector256.Max(nb, a) + h * h * quarterK;
+            }
+        }
+    }
+
+    private static float Combine(SdfNodeKind kind, float k, float a, float b)
+    {
+        switch (kind)
+        {
+            case SdfNodeKind.Union:
+                return MathF.Min(a, b);
+            case SdfNodeKind.Intersection:
+                return MathF.Max(a, b);
+            case SdfNodeKind.Difference:
+                return MathF.Max(a, -b);
+            case SdfNodeKind.SmoothUnion:
+            {
+                var h = MathF.Max(k - MathF.Abs(a - b), 0) / k;
+                return MathF.Min(a, b) - h * h * k * 0.25f;
+            }
+            case SdfNodeKind.SmoothIntersection:
+            {
+                var h = MathF.Max(k - MathF.Abs(a - b), 0) / k;
+                return MathF.Max(a, b) + h * h * k * 0.25f;
+            }
+            default:
+            {
+                var h = MathF.Max(k - MathF.Abs(-b - a), 0) / k;
+                return MathF.Max(-b, a) + h * h * k * 0.25f;
+            }
+        }
+    }
+
+    // Transforms
+
+    /// <summary>
+    /// Apply p' = M * p + t to every point, where M is a row-major 3x3 matrix
+    /// </summary>
+    public static void Affine(ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z,
+        Span<float> ox, Span<float> oy, Span<float> oz, ReadOnlySpan<float> m, float tx, float ty, float tz)
+    {
+        int i = 0, n = ox.Length;
+        ref var xr = ref MemoryMarshal.GetReference(x);
+        ref var yr = ref MemoryMarshal.GetReference(y);
+        ref var zr = ref MemoryMarshal.GetReference(z);
+        ref var oxr = ref MemoryMarshal.GetReference(ox);
+        ref var oyr = ref MemoryMarshal.GetReference(oy);
+        ref var ozr = ref MemoryMarshal.GetReference(oz);
+        float m00 = m[0], m01 = m[1], m02 = m[2];
+        float m10 = m[3], m11 = m[4], m12 = m[5];
+        float m20 = m[6], m21 = m[7], m22 = m[8];
+
+        if (Vector512.IsHardwareAccelerated)
+        {
+            for (; i <= n - Vector512<float>.Count; i += Vector512<float>.Count)
+            {
+                var px = Vector512.LoadUnsafe(ref xr, (nuint)i);
+                var py = Vector512.LoadUnsafe(ref yr, (nuint)i);
+                var pz = Vector512.LoadUnsafe(ref zr, (nuint)i);
+                (px * m00 + py * m01 + pz * m02 + Vector512.Create(tx)).StoreUnsafe(ref oxr, (nuint)i);
+                (px * m10 + py * m11 + pz * m12 + Vector512.Create(ty)).StoreUnsafe(ref oyr, (nuint)i);
+                (px * m20 + py * m21 + pz * m22 + Vector512.Create(tz)).StoreUnsafe(ref ozr, (nuint)i);
+            }
+        }
+        else if (Vector256.IsHardwareAccelerated)
+        {
+            for (; i <= n - Vector256<float>.Count; i += Vector256<float>.Count)
+            {
+                var px = Vector256.LoadUnsafe(ref xr, (nuint)i);
+                var py = Vector256.LoadUnsafe(ref yr, (nuint)i);
+                var pz = Vector256.LoadUnsafe(ref zr, (nuint)i);
+                (px * m00 + py * m01 + pz * m02 + Vector256.Create(tx)).StoreUnsafe(ref oxr, (nuint)i);
+                (px * m10 + py * m11 + pz * m12 + Vector256.Create(ty)).StoreUnsafe(ref oyr, (nuint)i);
+                (px * m20 + py * m21 + pz * m22 + Vector256.Create(tz)).StoreUnsafe(ref ozr, (nuint)i);
+            }
+        }
+
+        for (; i < n; i++)
+        {
+            float px = x[i], py = y[i], pz = z[i];
+            ox[i] = px * m00 + py * m01 + pz * m02 + tx;
+            oy[i] = px * m10 + py * m11 + pz * m12 + ty;
+            oz[i] = px * m20 + py * m21 + pz * m22 + tz;
+        }
+    }
+
+    // Distance modifiers
+
+    /// <summary>
+    /// Compute d = |d| * absScale + scale * d + offset in place, covering
+    /// scale (s, 0), dilate/erode (1, ∓r) and shell (|d| - t)
+    /// </summary>
+    public static void Modify(Span<float> d, float scale, float absScale, float offset)
+    {
+        int i = 0, n = d.Length;
+        ref var dr = ref MemoryMarshal.GetReference(d);
+
+        if (Vector512.IsHardwareAccelerated)
+        {
+            var vs = Vector512.Create(scale);
+            var va = Vector512.Create(absScale);
+            var vo = Vector512.Create(offset);
+            for (; i <= n - Vector512<float>.Count; i += Vector512<float>.Count)
+            {
+                var v = Vector512.LoadUnsafe(ref dr, (nuint)i);
+                (Vector512.Abs(v) * va + v * vs + vo).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+        else if (Vector256.IsHardwareAccelerated)
+        {
+            var vs = Vector256.Create(scale);
+            var va = Vector256.Create(absScale);
+            var vo = Vector256.Create(offset);
+            for (; i <= n - Vector256<float>.Count; i += Vector256<float>.Count)
+            {
+                var v = Vector256.LoadUnsafe(ref dr, (nuint)i);
+                (Vector256.Abs(v) * va + v * vs + vo).StoreUnsafe(ref dr, (nuint)i);
+            }
+        }
+
+        for (; i < n; i++)
+        {
+            d[i] = MathF.Abs(d[i]) * absScale + d[i] * scale + offset;
+        }
+    }
+}
@@ -19,6 +19,14 @@ public static class StlWriter
         WriteBinaryStl(path, new List<Vector3>(triangles));
     }
 
+    /// <summary>
+    /// Write an indexed mesh to a binary STL file, which repeats shared vertices
+    /// </summary>
+    public static void WriteBinaryStl(string path, IndexedMesh mesh)
+    {
+        WriteBinaryStl(path, mesh.ToTriangles());
+    }
+
     /// <summary>
     /// Write triangles to a binary STL file
     /// </summary>
@@ -55,22 +63,22 @@ public static class StlWriter
             var normal = Vector3.Normalize(Vector3.Cross(edge1, edge2));
 
             // Write normal
-            writer.Write(normal.X);
-            writer.Write(normal.Y);
-            writer.Write(normal.Z);
+            writer.Write((float)normal.X);
+            writer.Write((float)normal.Y);
+            writer.Write((float)normal.Z);
 
             // Write vertices
-            writer.Write(v1.X);
-            writer.Write(v1.Y);
-            writer.Write(v1.Z);
+            writer.Write((float)v1.X);
+            writer.Write((float)v1.Y);
+            writer.Write((float)v1.Z);
 
-            writer.Write(v2.X);
-            writer.Write(v2.Y);
-            writer.Write(v2.Z);
+            writer.Write((float)v2.X);
+            writer.Write((float)v2.Y);
+            writer.Write((float)v2.Z);
 
-            writer.Write(v3.X);
-            writer.Write(v3.Y);
-            writer.Write(v3.Z);
+            writer.Write((float)v3.X);
+            writer.Write((float)v3.Y);
+            writer.Write((float)v3.Z);
 
             // Write attribute byte count (unused)
             writer.Write((ushort)0);
@@ -0,0 +1,54 @@
+using System;
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Compares SDF3 graphs by structure: two nodes are equal when they have the
+/// same kind, bit-identical parameters, the same custom function, the same
+/// bake step and equal children. Hashes are cached on the nodes, so lookups stay cheap.
+/// </summary>
+internal sealed class StructuralComparer : IEqualityComparer<SDF3>
+{
+    public static readonly StructuralComparer Instance = new();
+
+    public bool Equals(SDF3? a, SDF3? b)
+    {
+        if (ReferenceEquals(a, b))
+            return true;
+        if (a is null || b is null)
+            return false;
+        if (a.Kind != b.Kind || a.StructuralHash != b.StructuralHash)
+            return false;
+        if (!ReferenceEquals(a.Function, b.Function) || a.BakeStep != b.BakeStep || a.Args.Length != b.Args.Length || a.Inputs.Length != b.Inputs.Length)
+            return false;
+        for (int i = 0; i < a.Args.Length; i++)
+        {
+            if (BitConverter.DoubleToInt64Bits(a.Args[i]) != BitConverter.DoubleToInt64Bits(b.Args[i]))
+                return false;
+        }
+        for (int i = 0; i < a.Inputs.Length; i++)
+        {
+            if (!Equals(a.Inputs[i], b.Inputs[i]))
+                return false;
+        }
+        return true;
+    }
+
+    public int GetHashCode(SDF3 node) => node.StructuralHash;
+
+    internal static int ComputeHash(SDF3 node)
+    {
+        var hash = new HashCode();
+        hash.Add(node.Kind);
+        if (node.Function != null)
+            hash.Add(node.Function);
+        if (node.BakeStep is { } step)
+            hash.Add(BitConverter.DoubleToInt64Bits(step));
+        foreach (var arg in node.Args)
+            hash.Add(BitConverter.DoubleToInt64Bits(arg));
+        foreach (var child in node.Inputs)
+            hash.Add(child.StructuralHash);
+        return hash.ToHashCode();
+    }
+}
@@ -0,0 +1,61 @@
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Settings of tiered evaluation. The interpreters count the points every
+/// subtree handles, and once a subtree has handled <see cref="Threshold"/>
+/// of them it is promoted in the background: subtrees without custom leaves
+/// are compiled into fused kernels, and subtrees marked with
+/// <see cref="SDF3.Static"/> are baked into a sampled grid. Evaluation goes on
+/// through the interpreter until the promoted form is ready, so long jobs
+/// speed up on their own. Profiled evaluation is never promoted. Meshing
+/// bakes static subtrees before sampling instead, so every batch of a mesh
+/// samples the same field.
+/// </summary>
+public static class TieredEvaluation
+{
+    /// <summary>
+    /// Whether subtrees are counted and promoted at all
+    /// </summary>
+    public static bool Enabled { get; set; } = true;
+
+    /// <summary>
+    /// Points a subtree handles before it is promoted
+    /// </summary>
+    public static long Threshold { get; set; } = 1 << 18;
+
+    /// <summary>
+    /// Largest grid a static subtree is baked into; subtrees whose bounds need
+    /// more samples at their step are compiled instead, or left interpreted
+    /// when they have custom leaves
+    /// </summary>
+    public static int MaxBakeSamples { get; set; } = 1 << 21;
+
+    /// <summary>
+    /// Promote every static subtree of <paramref name="root"/> now, innermost
+    /// first, waiting for promotions already under way
+    /// </summary>
+    internal static void Bake(SDF3 root)
+    {
+        if (Enabled)
+            Bake(root, new HashSet<SDF3>(ReferenceEqualityComparer.Instance));
+    }
+
+    private static void Bake(SDF3 node, HashSet<SDF3> visited)
+    {
+        if (!node.HasStatic || !visited.Add(node))
+            return;
+        foreach (var input in node.Inputs)
+            Bake(input, visited);
+        if (node.BakeStep != null)
+            node.Tier.Settle(node);
+    }
+
+    /// <summary>
+    /// Grid the evaluators read <paramref name="node"/> from, or null when they
+    /// evaluate it exactly
+    /// </summary>
+    internal static BakedGrid? Grid(SDF3 node) =>
+        Enabled && node.BakeStep != null && Profiler.Current == null ? node.Tier.Grid : null;
+}
@@ -0,0 +1,90 @@
+using System;
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Folds chains of translations, rotations and uniform scales into single
+/// <see cref="SdfNodeKind.Affine"/> nodes, so a stack of transforms costs one
+/// pass over the points instead of one per transform.
+/// </summary>
+internal static class TransformFolding
+{
+    public static SDF3 Fold(SDF3 root)
+    {
+        // Keyed by reference so shared subtrees stay shared
+        return Fold(root, new Dictionary<SDF3, SDF3>(ReferenceEqualityComparer.Instance));
+    }
+
+    private static SDF3 Fold(SDF3 node, Dictionary<SDF3, SDF3> folded)
+    {
+        if (folded.TryGetValue(node, out var existing))
+            return existing;
+
+        var children = new SDF3[node.Inputs.Length];
+        for (int i = 0; i < children.Length; i++)
+            children[i] = Fold(node.Inputs[i], folded);
+
+        var result = node.WithInputs(children);
+        // Static nodes keep their place in the tree, since they are baked as they are
+        if (IsSimilarity(result.Kind) && IsSimilarity(children[0].Kind)
+            && result.BakeStep == null && children[0].BakeStep == null)
+            result = Compose(result, children[0]);
+        folded[node] = result;
+        return result;
+    }
+
+    private static bool IsSimilarity(SdfNodeKind kind) =>
+        kind is SdfNodeKind.Translate or SdfNodeKind.Rotate or SdfNodeKind.Scale or SdfNodeKind.Affine;
+
+    /// <summary>
+    /// One affine node doing the work of <paramref name="outer"/> followed by its
+    /// child <paramref name="inner"/>
+    /// </summary>
+    private static SDF3 Compose(SDF3 outer, SDF3 inner)
+    {
+        // The outer node hands its child q = A p + a, which the inner node maps
+        // to B q + b = (B A) p + (B a + b); both scale the distance they return
+        var (ma, sa) = ToAffine(outer);
+        var (mb, sb) = ToAffine(inner);
+        var args = new double[13];
+        for (int r = 0; r < 3; r++)
+        {
+            for (int c = 0; c < 3; c++)
+                args[3 * r + c] = mb[3 * r] * ma[c] + mb[3 * r + 1] * ma[3 + c] + mb[3 * r + 2] * ma[6 + c];
+            args[9 + r] = mb[3 * r] * ma[9] + mb[3 * r + 1] * ma[10] + mb[3 * r + 2] * ma[11] + mb[9 + r];
+        }
+        args[12] = sa * sb;
+        return new SDF3(SdfNodeKind.Affine, args, inner.Inputs[0]);
+    }
+
+    /// <summary>
+    /// Row-major 3x4 map [M | t] a transform node applies to its points, and the
+    /// factor it applies to its child's distance
+    /// </summary>
+    private static (double[] map, double scale) ToAffine(SDF3 node)
+    {
+        var a = node.Args;
+        var map = new double[12];
+        switch (node.Kind)
+        {
+            case SdfNodeKind.Translate:
+                map[0] = map[4] = map[8] = 1;
+                map[9] = -a[0];
+                map[10] = -a[1];
+                map[11] = -a[2];
+                return (map, 1);
+            case SdfNodeKind.Scale:
+                map[0] = map[4] = map[8] = 1.0 / a[0];
+                return (map, a[0]);
+            case SdfNodeKind.Rotate:
+                Evaluator.RotationMatrix(a[0], Evaluator.Vec(a, 1), map);
+                return (map, 1);
+            case SdfNodeKind.Affine:
+                Array.Copy(a, map, 12);
+                return (map, a[12]);
+            default:
+                throw new ArgumentException($"{node.Kind} is not a similarity transform", nameof(node));
+        }
+    }
+}
@@ -0,0 +1,345 @@
+using System;
+using System.Buffers;
+using System.Collections.Generic;
+
+namespace SDF;
+
+/// <summary>
+/// Bounding volume hierarchy over the children of an n-ary union. A child is
+/// only evaluated at points where its box is closer than the best value found so
+/// far plus the blend radius k, so the cost per point follows the number of
+/// nearby children instead of the total. Children without finite bounds are
+/// evaluated everywhere.
+/// </summary>
+/// <remarks>
+/// Skipping a child is exact when its value outside its box is at least the
+/// distance to the box, which holds for distance fields. For looser fields the
+/// sign of the result is still exact.
+/// </remarks>
+internal sealed class UnionBvh
+{
+    // Six bounds per node: min x, y, z then max x, y, z
+    private readonly double[] _bounds;
+    // Leaves store the child index in _first and -1 in _second; inner nodes store both subtrees
+    private readonly int[] _first;
+    private readonly int[] _second;
+    private readonly int[] _unbounded;
+    private int _count;
+
+    public UnionBvh(SDF3[] children)
+    {
+        var items = new List<(int index, Vector3 min, Vector3 max)>();
+        var unbounded = new List<int>();
+        for (int i = 0; i < children.Length; i++)
+        {
+            if (children[i].Bounds is { } box)
+                items.Add((i, box.min, box.max));
+            else
+                unbounded.Add(i);
+        }
+
+        var nodes = Math.Max(2 * items.Count - 1, 0);
+        _bounds = new double[6 * nodes];
+        _first = new int[nodes];
+        _second = new int[nodes];
+        _unbounded = unbounded.ToArray();
+        if (items.Count > 0)
+            Build(items, 0, items.Count);
+    }
+
+    private int Build(List<(int index, Vector3 min, Vector3 max)> items, int lo, int hi)
+    {
+        int node = _count++;
+        var min = items[lo].min;
+        var max = items[lo].max;
+        var cmin = (items[lo].min + items[lo].max) * 0.5;
+        var cmax = cmin;
+        for (int i = lo + 1; i < hi; i++)
+        {
+            var (_, bmin, bmax) = items[i];
+            min = new Vector3(Math.Min(min.X, bmin.X), Math.Min(min.Y, bmin.Y), Math.Min(min.Z, bmin.Z));
+            max = new Vector3(Math.Max(max.X, bmax.X), Math.Max(max.Y, bmax.Y), Math.Max(max.Z, bmax.Z));
+            var c = (bmin + bmax) * 0.5;
+            cmin = new Vector3(Math.Min(cmin.X, c.X), Math.Min(cmin.Y, c.Y), Math.Min(cmin.Z, c.Z));
+            cmax = new Vector3(Math.Max(cmax.X, c.X), Math.Max(cmax.Y, c.Y), Math.Max(cmax.Z, c.Z));
+        }
+        _bounds[6 * node + 0] = min.X;
+        _bounds[6 * node + 1] = min.Y;
+        _bounds[6 * node + 2] = min.Z;
+        _bounds[6 * node + 3] = max.X;
+        _bounds[6 * node + 4] = max.Y;
+        _bounds[6 * node + 5] = max.Z;
+
+        if (hi - lo == 1)
+        {
+            _first[node] = items[lo].index;
+            _second[node] = -1;
+            return node;
+        }
+
+        // Median split along the axis where the child centers spread the most
+        var spread = cmax - cmin;
+        Func<(int index, Vector3 min, Vector3 max), double> key =
+            spread.X >= spread.Y && spread.X >= spread.Z ? b => b.min.X + b.max.X
+            : spread.Y >= spread.Z ? b => b.min.Y + b.max.Y
+            : b => b.min.Z + b.max.Z;
+        items.Sort(lo, hi - lo, Comparer<(int index, Vector3 min, Vector3 max)>.Create((a, b) => key(a).CompareTo(key(b))));
+
+        int mid = (lo + hi) / 2;
+        _first[node] = Build(items, lo, mid);
+        _second[node] = Build(items, mid, hi);
+        return node;
+    }
+
+    private double BoxDistance(int node, double x, double y, double z)
+    {
+        var b = _bounds.AsSpan(6 * node, 6);
+        var dx = Math.Max(Math.Max(b[0] - x, x - b[3]), 0);
+        var dy = Math.Max(Math.Max(b[1] - y, y - b[4]), 0);
+        var dz = Math.Max(Math.Max(b[2] - z, z - b[5]), 0);
+        return Math.Sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    /// <summary>
+    /// Whether a child inside this node can still change the result at a point.
+    /// Points inside the box are always visited so values inside the solid stay exact.
+    /// </summary>
+    private bool Visits(int node, double x, double y, double z, double best, double k)
+    {
+        var distance = BoxDistance(node, x, y, z);
+        return distance <= 0 || distance < best + k;
+    }
+
+    /// <summary>
+    /// Track the two smallest child values
+    /// </summary>
+    private static void Fold(double value, ref double best, ref double second)
+    {
+        if (value < best)
+        {
+            second = best;
+            best = value;
+        }
+        else if (value < second)
+        {
+            second = value;
+        }
+    }
+
+    /// <summary>
+    /// Polynomial smooth minimum of the two closest children, which reduces to
+    /// the binary smooth union for two children and ignores the order of children
+    /// </summary>
+    private static double Blend(double best, double second, double k)
+    {
+        if (k <= 0)
+            return best;
+        var h = Math.Max(k - Math.Abs(best - second), 0.0) / k;
+        return best - h * h * k * (1.0 / 4.0);
+    }
+
+    /// <summary>
+    /// Evaluate the union at a single point with one compiled kernel per child
+    /// </summary>
+    public double Evaluate(double x, double y, double z, double k, Func<double, double, double, double>[] kernels)
+    {
+        double best = double.PositiveInfinity;
+        double second = double.PositiveInfinity;
+        foreach (var i in _unbounded)
+            Fold(kernels[i](x, y, z), ref best, ref second);
+        if (_count > 0)
+            Visit(0, x, y, z, k, kernels, ref best, ref second);
+        return Blend(best, second, k);
+    }
+
+    private void Visit(int node, double x, double y, double z, double k, Func<double, double, double, double>[] kernels,
+        ref double best, ref double second)
+    {
+        if (!Visits(node, x, y, z, best, k))
+            return;
+        if (_second[node] < 0)
+        {
+            Fold(kernels[_first[node]](x, y, z), ref best, ref second);
+            return;
+        }
+
+        // Nearer subtree first, so the bound tightens before the farther one is tested
+        int a = _first[node], b = _second[node];
+        if (BoxDistance(b, x, y, z) < BoxDistance(a, x, y, z))
+            (a, b) = (b, a);
+        Visit(a, x, y, z, k, kernels, ref best, ref second);
+        Visit(b, x, y, z, k, kernels, ref best, ref second);
+    }
+
+    /// <summary>
+    /// Evaluate the union at many points, visiting each subtree with the packet of
+    /// points it can still affect
+    /// </summary>
+    public double[] Evaluate(SDF3[] children, double k, Vector3[] points)
+    {
+        int n = points.Length;
+        var best = new double[n];
+        var second = new double[n];
+        Array.Fill(best, double.PositiveInfinity);
+        Array.Fill(second, double.PositiveInfinity);
+
+        var all = ArrayPool<int>.Shared.Rent(n);
+        var center = Vector3.Zero;
+        for (int i = 0; i < n; i++)
+        {
+            all[i] = i;
+            center += points[i];
+        }
+        center /= Math.Max(n, 1);
+
+        foreach (var child in _unbounded)
+            FoldPacket(children[child], points, all, n, best, second);
+        if (_count > 0)
+            VisitPacket(0, children, k, points, all, n, center, best, second);
+        ArrayPool<int>.Shared.Return(all);
+
+        for (int i = 0; i < n; i++)
+            best[i] = Blend(best[i], second[i], k);
+        return best;
+    }
+
+    private void VisitPacket(int node, SDF3[] children, double k, Vector3[] points, int[] active, int count,
+        Vector3 center, double[] best, double[] second)
+    {
+        var subset = ArrayPool<int>.Shared.Rent(count);
+        int m = 0;
+        for (int j = 0; j < count; j++)
+        {
+            var i = active[j];
+            var p = points[i];
+            if (Visits(node, p.X, p.Y, p.Z, best[i], k))
+                subset[m++] = i;
+        }
+
+        if (m > 0)
+        {
+            if (_second[node] < 0)
+            {
+                FoldPacket(children[_first[node]], points, subset, m, best, second);
+            }
+            else
+            {
+                int a = _first[node], b = _second[node];
+                if (BoxDistance(b, center.X, center.Y, center.Z) < BoxDistance(a, center.X, center.Y, center.Z))
+                    (a, b) = (b, a);
+                VisitPacket(a, children, k, points, subset, m, center, best, second);
+                VisitPacket(b, children, k, points, subset, m, center, best, second);
+            }
+        }
+        ArrayPool<int>.Shared.Return(subset);
+    }
+
+    private static void FoldPacket(SDF3 child, Vector3[] points, int[] active, int count, double[] best, double[] second)
+    {
+        var gathered = new Vector3[count];
+        for (int j = 0; j < count; j++)
+            gathered[j] = points[active[j]];
+        var values = Evaluator.Evaluate(child, gathered);
+        for (int j = 0; j < count; j++)
+            Fold(values[j], ref best[active[j]], ref second[active[j]]);
+    }
+
+    /// <summary>
+    /// Evaluate the union over structure-of-arrays float lanes, gathering the
+    /// points each child can affect into scratch buffers
+    /// </summary>
+    public void Evaluate(SDF3[] children, double k, ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z,
+        Span<float> d, EvalScratch scratch)
+    {
+        int n = d.Length;
+        var mark = scratch.Mark;
+        var second = scratch.Rent(n);
+        d.Fill(float.PositiveInfinity);
+        second.Fill(float.PositiveInfinity);
+
+        var all = ArrayPool<int>.Shared.Rent(n);
+        double cx = 0, cy = 0, cz = 0;
+        for (int i = 0; i < n; i++)
+        {
+            all[i] = i;
+            cx += x[i];
+            cy += y[i];
+            cz += z[i];
+        }
+        var center = new Vector3(cx, cy, cz) / Math.Max(n, 1);
+
+        foreach (var child in _unbounded)
+            FoldPacket(children[child], x, y, z, all, n, d, second, scratch);
+        if (_count > 0)
+            VisitPacket(0, children, k, x, y, z, all, n, center, d, second, scratch);
+        ArrayPool<int>.Shared.Return(all);
+
+        for (int i = 0; i < n; i++)
+            d[i] = (float)Blend(d[i], second[i], k);
+        scratch.Release(mark);
+    }
+
+    private void VisitPacket(int node, SDF3[] children, double k, ReadOnlySpan<float> x, ReadOnlySpan<float> y,
+        ReadOnlySpan<float> z, int[] active, int count, Vector3 center, Span<float> best, Span<float> second,
+        EvalScratch scratch)
+    {
+        var subset = ArrayPool<int>.Shared.Rent(count);
+        int m = 0;
+        for (int j = 0; j < count; j++)
+        {
+            var i = active[j];
+            if (Visits(node, x[i], y[i], z[i], best[i], k))
+                subset[m++] = i;
+        }
+
+        if (m > 0)
+        {
+            if (_second[node] < 0)
+            {
+                FoldPacket(children[_first[node]], x, y, z, subset, m, best, second, scratch);
+            }
+            else
+            {
+                int a = _first[node], b = _second[node];
+                if (BoxDistance(b, center.X, center.Y, center.Z) < BoxDistance(a, center.X, center.Y, center.Z))
+                    (a, b) = (b, a);
+                VisitPacket(a, children, k, x, y, z, subset, m, center, best, second, scratch);
+                VisitPacket(b, children, k, x, y, z, subset, m, center, best, second, scratch);
+            }
+        }
+        ArrayPool<int>.Shared.Return(subset);
+    }
+
+    private static void FoldPacket(SDF3 child, ReadOnlySpan<float> x, ReadOnlySpan<float> y, ReadOnlySpan<float> z,
+        int[] active, int count, Span<float> best, Span<float> second, EvalScratch scratch)
+    {
+        var mark = scratch.Mark;
+        var gx = scratch.Rent(count);
+        var gy = scratch.Rent(count);
+        var gz = scratch.Rent(count);
+        var values = scratch.Rent(count);
+        for (int j = 0; j < count; j++)
+        {
+            var i = active[j];
+            gx[j] = x[i];
+            gy[j] = y[i];
+            gz[j] = z[i];
+        }
+        Evaluator.Evaluate(child, gx, gy, gz, values, scratch);
+        for (int j = 0; j < count; j++)
+        {
+            var i = active[j];
+            var v = values[j];
+            if (v < best[i])
+            {
+                second[i] = best[i];
+                best[i] = v;
+            }
+            else if (v < second[i])
+            {
+                second[i] = v;
+            }
+        }
+        scratch.Release(mark);
+    }
+}
@@ -236,8 +236,8 @@ public static class ComprehensiveExamples
             .Rotate(Pi / 2, Y)
             .Translate(new Vector3(0, 0, 1));
 
-        // Combine all elements
-        var scene = platform | pillar | sphere1 | sphere2 | sphere3 | sphere4 | torus1 | torus2;
+        // Combine all elements in one n-ary union
+        var scene = Union(new[] { platform, pillar, sphere1, sphere2, sphere3, sphere4, torus1, torus2 });
 
         Console.WriteLine("  Generating complex scene...");
         scene.Save("complex-scene.stl", samples: 1 << 23, verbose: false);
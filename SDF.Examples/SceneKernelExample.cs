@@ -0,0 +1,33 @@
+using SDF;
+using static SDF.Primitives;
+using static SDF.Operations;
+using static SDF.Constants;
+
+namespace SDF.Examples;
+
+/// <summary>
+/// The CSG example declared as a scene fixed at build time. SDF.Generators
+/// specializes it into CSGKernel, so meshing it needs no run-time compilation.
+/// </summary>
+public static partial class SceneKernelExample
+{
+    [SdfScene]
+    public static SDF3 CSG()
+    {
+        var f = Sphere(1.0) & Box(1.5);
+        var c = Cylinder(0.5);
+        return f - (c.Orient(X) | c.Orient(Y) | c.Orient(Z));
+    }
+
+    public static void Run()
+    {
+        Console.WriteLine("Running scene kernel example (CSG specialized at build time)...");
+        Console.WriteLine();
+
+        // CSGCompiled is generated next to CSG and carries the generated kernel
+        CSGCompiled().Save("scene-kernel.stl", samples: 1 << 20, verbose: true);
+
+        Console.WriteLine();
+        Console.WriteLine("Scene kernel example complete! Mesh saved to scene-kernel.stl");
+    }
+}
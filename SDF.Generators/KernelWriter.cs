@@ -0,0 +1,272 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text;
+
+namespace SDF.Generators;
+
+/// <summary>
+/// Writes the body of a per-point kernel for a scene tree. The formulas match
+/// the library's expression compiler, with every argument written as a literal,
+/// so the C# compiler and JIT fold them like any other constants.
+/// </summary>
+internal sealed class KernelWriter
+{
+    private const string MathType = "global::System.Math";
+    private const string Zero = "0d";
+    private const string One = "1d";
+
+    private readonly StringBuilder _body = new();
+    private readonly Dictionary<(SceneNode, string, string, string), string> _emitted = new();
+    private readonly string _indent;
+    private int _variables;
+
+    private KernelWriter(string indent)
+    {
+        _indent = indent;
+    }
+
+    /// <summary>
+    /// Statements computing the distance of <paramref name="root"/> at
+    /// <c>x</c>, <c>y</c> and <c>z</c>, ending in a return
+    /// </summary>
+    public static string Write(SceneNode root, string indent)
+    {
+        var writer = new KernelWriter(indent);
+        var result = writer.Emit(root, "x", "y", "z");
+        writer._body.Append(indent).Append("return ").Append(result).Append(";\n");
+        return writer._body.ToString();
+    }
+
+    /// <summary>
+    /// Emit a node, reusing the variable already holding its value when the
+    /// same node was emitted at the same coordinates
+    /// </summary>
+    private string Emit(SceneNode node, string x, string y, string z)
+    {
+        if (_emitted.TryGetValue((node, x, y, z), out var value))
+            return value;
+        value = EmitNode(node, x, y, z);
+        _emitted[(node, x, y, z)] = value;
+        return value;
+    }
+
+    private string EmitNode(SceneNode node, string x, string y, string z)
+    {
+        var a = node.Args;
+        switch (node.Kind)
+        {
+            case "Sphere":
+            {
+                var dx = Let(Sub(x, C(a[1])));
+                var dy = Let(Sub(y, C(a[2])));
+                var dz = Let(Sub(z, C(a[3])));
+                return Let(Sub(Length(dx, dy, dz), C(a[0])));
+            }
+            case "Box":
+            {
+                var qx = Let(Sub(Abs(Sub(x, C(a[3]))), C(a[0] / 2.0)));
+                var qy = Let(Sub(Abs(Sub(y, C(a[4]))), C(a[1] / 2.0)));
+                var qz = Let(Sub(Abs(Sub(z, C(a[5]))), C(a[2] / 2.0)));
+                return Let(BoxDistance(qx, qy, qz));
+            }
+            case "Cylinder":
+                return Let(Sub(Sqrt(Add(Mul(x, x), Mul(y, y))), C(a[0])));
+            case "CappedCylinder":
+            {
+                var (bax, bay, baz) = (a[3] - a[0], a[4] - a[1], a[5] - a[2]);
+                var baba = bax * bax + bay * bay + baz * baz;
+                var pax = Let(Sub(x, C(a[0])));
+                var pay = Let(Sub(y, C(a[1])));
+                var paz = Let(Sub(z, C(a[2])));
+                var paba = Let(Dot(pax, pay, paz, bax, bay, baz));
+                var cx = Let(Sub(Mul(pax, C(baba)), Mul(C(bax), paba)));
+                var cy = Let(Sub(Mul(pay, C(baba)), Mul(C(bay), paba)));
+                var cz = Let(Sub(Mul(paz, C(baba)), Mul(C(baz), paba)));
+                var qx = Let(Sub(Length(cx, cy, cz), C(a[6] * baba)));
+                var qy = Let(Sub(Abs(Sub(paba, C(baba * 0.5))), C(baba * 0.5)));
+                var x2 = Let(Mul(qx, qx));
+                var y2 = Let(Mul(Mul(qy, qy), C(baba)));
+                var d = Let($"({Max(qx, qy)} < 0.0 ? -{Min(x2, y2)} : ({qx} > 0.0 ? {x2} : 0.0) + ({qy} > 0.0 ? {y2} : 0.0))");
+                return Let(Div(Mul($"{MathType}.Sign({d})", $"{MathType}.Sqrt({MathType}.Abs({d}))"), C(baba)));
+            }
+            case "Plane":
+                return Let(Add(Add(
+                    Mul(Sub(x, C(a[3])), C(a[0])),
+                    Mul(Sub(y, C(a[4])), C(a[1]))),
+                    Mul(Sub(z, C(a[5])), C(a[2]))));
+            case "Torus":
+            {
+                var qx = Let(Sub(Sqrt(Add(Mul(x, x), Mul(y, y))), C(a[0])));
+                return Let(Sub(Sqrt(Add(Mul(qx, qx), Mul(z, z))), C(a[1])));
+            }
+            case "RoundedBox":
+            {
+                var radius = a[3];
+                var qx = Let(Sub(Abs(x), C(a[0] / 2.0 - radius)));
+                var qy = Let(Sub(Abs(y), C(a[1] / 2.0 - radius)));
+                var qz = Let(Sub(Abs(z), C(a[2] / 2.0 - radius)));
+                return Let(Sub(BoxDistance(qx, qy, qz), C(radius)));
+            }
+            case "Capsule":
+            {
+                var (bax, bay, baz) = (a[3] - a[0], a[4] - a[1], a[5] - a[2]);
+                var baba = bax * bax + bay * bay + baz * baz;
+                var pax = Let(Sub(x, C(a[0])));
+                var pay = Let(Sub(y, C(a[1])));
+                var paz = Let(Sub(z, C(a[2])));
+                var h = Let($"{MathType}.Clamp({Div(Dot(pax, pay, paz, bax, bay, baz), C(baba))}, {Zero}, {One})");
+                var dx = Let(Sub(pax, Mul(C(bax), h)));
+                var dy = Let(Sub(pay, Mul(C(bay), h)));
+                var dz = Let(Sub(paz, Mul(C(baz), h)));
+                return Let(Sub(Length(dx, dy, dz), C(a[6])));
+            }
+            case "Ellipsoid":
+            {
+                var k0x = Let(Div(x, C(a[0])));
+                var k0y = Let(Div(y, C(a[1])));
+                var k0z = Let(Div(z, C(a[2])));
+                var k1x = Let(Div(x, C(a[0] * a[0])));
+                var k1y = Let(Div(y, C(a[1] * a[1])));
+                var k1z = Let(Div(z, C(a[2] * a[2])));
+                var k0 = Let(Length(k0x, k0y, k0z));
+                var k1 = Let(Length(k1x, k1y, k1z));
+                return Let(Div(Mul(k0, Sub(k0, One)), k1));
+            }
+
+            case "Union":
+                return Let(Min(Emit(node.Inputs[0], x, y, z), Emit(node.Inputs[1], x, y, z)));
+            case "Intersection":
+                return Let(Max(Emit(node.Inputs[0], x, y, z), Emit(node.Inputs[1], x, y, z)));
+            case "Difference":
+                return Let(Max(Emit(node.Inputs[0], x, y, z), $"-{Emit(node.Inputs[1], x, y, z)}"));
+            case "SmoothUnion":
+            case "SmoothIntersection":
+            {
+                var k = a[0];
+                var da = Emit(node.Inputs[0], x, y, z);
+                var db = Emit(node.Inputs[1], x, y, z);
+                var h = Let(Div(Max(Sub(C(k), Abs(Sub(da, db))), Zero), C(k)));
+                var blend = Mul(Mul(h, h), C(k * (1.0 / 4.0)));
+                return node.Kind == "SmoothUnion"
+                    ? Let(Sub(Min(da, db), blend))
+                    : Let(Add(Max(da, db), blend));
+            }
+            case "SmoothDifference":
+            {
+                var k = a[0];
+                var da = Emit(node.Inputs[0], x, y, z);
+                var nb = Let($"-{Emit(node.Inputs[1], x, y, z)}");
+                var h = Let(Div(Max(Sub(C(k), Abs(Sub(nb, da))), Zero), C(k)));
+                return Let(Add(Max(nb, da), Mul(Mul(h, h), C(k * (1.0 / 4.0)))));
+            }
+
+            case "Translate":
+                return Emit(node.Inputs[0], Let(Sub(x, C(a[0]))), Let(Sub(y, C(a[1]))), Let(Sub(z, C(a[2]))));
+            case "Scale":
+            {
+                var d = Emit(node.Inputs[0], Let(Div(x, C(a[0]))), Let(Div(y, C(a[0]))), Let(Div(z, C(a[0]))));
+                return Let(Mul(d, C(a[0])));
+            }
+            case "Rotate":
+            {
+                var cos = Math.Cos(a[0]);
+                var sin = Math.Sin(a[0]);
+                var (ux, uy, uz) = (a[1], a[2], a[3]);
+                var dot = Let(Dot(x, y, z, ux, uy, uz));
+                // axis * dot + cross(axis, p) * sin + (p - axis * dot) * cos
+                var rx = Let(Add(Add(Mul(C(ux), dot), Mul(Sub(Mul(C(uy), z), Mul(C(uz), y)), C(sin))), Mul(Sub(x, Mul(C(ux), dot)), C(cos))));
+                var ry = Let(Add(Add(Mul(C(uy), dot), Mul(Sub(Mul(C(uz), x), Mul(C(ux), z)), C(sin))), Mul(Sub(y, Mul(C(uy), dot)), C(cos))));
+                var rz = Let(Add(Add(Mul(C(uz), dot), Mul(Sub(Mul(C(ux), y), Mul(C(uy), x)), C(sin))), Mul(Sub(z, Mul(C(uz), dot)), C(cos))));
+                return Emit(node.Inputs[0], rx, ry, rz);
+            }
+            case "Twist":
+            case "Bend":
+            {
+                var angle = Mul(C(a[0]), node.Kind == "Twist" ? z : x);
+                var c = Let($"{MathType}.Cos({angle})");
+                var s = Let($"{MathType}.Sin({angle})");
+                var tx = Let(Sub(Mul(c, x), Mul(s, y)));
+                var ty = Let(Add(Mul(s, x), Mul(c, y)));
+                return Emit(node.Inputs[0], tx, ty, z);
+            }
+            case "Elongate":
+            {
+                var mx = Let(Max(Sub(Abs(x), C(a[0])), Zero));
+                var my = Let(Max(Sub(Abs(y), C(a[1])), Zero));
+                var mz = Let(Max(Sub(Abs(z), C(a[2])), Zero));
+                var d = Emit(node.Inputs[0], Let(Mul($"{MathType}.Sign({x})", mx)), Let(Mul($"{MathType}.Sign({y})", my)), Let(Mul($"{MathType}.Sign({z})", mz)));
+                return Let(Add(d, Length(mx, my, mz)));
+            }
+            case "Repeat":
+                return Emit(node.Inputs[0],
+                    Let(RepeatAxis(x, a[0], a[3])),
+                    Let(RepeatAxis(y, a[1], a[4])),
+                    Let(RepeatAxis(z, a[2], a[5])));
+
+            case "Dilate":
+                return Let(Sub(Emit(node.Inputs[0], x, y, z), C(a[0])));
+            case "Erode":
+                return Let(Add(Emit(node.Inputs[0], x, y, z), C(a[0])));
+            case "Shell":
+                return Let(Sub(Abs(Emit(node.Inputs[0], x, y, z)), C(a[0])));
+
+            default:
+                throw new InvalidOperationException($"Cannot write a kernel for {node.Kind}");
+        }
+    }
+
+    private string Let(string value)
+    {
+        var name = $"v{_variables++}";
+        _body.Append(_indent).Append("double ").Append(name).Append(" = ").Append(value).Append(";\n");
+        return name;
+    }
+
+    /// <summary>
+    /// A double literal that reads back as exactly <paramref name="value"/>
+    /// </summary>
+    private static string C(double value)
+    {
+        if (double.IsPositiveInfinity(value))
+            return "double.PositiveInfinity";
+        if (double.IsNegativeInfinity(value))
+            return "double.NegativeInfinity";
+        if (double.IsNaN(value))
+            return "double.NaN";
+        var text = value.ToString("R", CultureInfo.InvariantCulture) + "d";
+        return value < 0 ? $"({text})" : text;
+    }
+
+    // Terms with literal zeros and ones are dropped: the JIT must keep x * 0
+    // for infinite x, but sample coordinates are always finite
+    private static string Add(string a, string b) => a == Zero ? b : b == Zero ? a : $"({a} + {b})";
+    private static string Sub(string a, string b) => b == Zero ? a : a == Zero ? $"(-{b})" : $"({a} - {b})";
+    private static string Mul(string a, string b) =>
+        a == Zero || b == Zero ? Zero : a == One ? b : b == One ? a : $"({a} * {b})";
+    private static string Div(string a, string b) => b == One ? a : $"({a} / {b})";
+    private static string Sqrt(string a) => $"{MathType}.Sqrt({a})";
+    private static string Abs(string a) => $"{MathType}.Abs({a})";
+    private static string Min(string a, string b) => $"{MathType}.Min({a}, {b})";
+    private static string Max(string a, string b) => $"{MathType}.Max({a}, {b})";
+
+    private static string Length(string x, string y, string z) =>
+        Sqrt(Add(Add(Mul(x, x), Mul(y, y)), Mul(z, z)));
+
+    private static string Dot(string x, string y, string z, double vx, double vy, double vz) =>
+        Add(Add(Mul(x, C(vx)), Mul(y, C(vy))), Mul(z, C(vz)));
+
+    private string BoxDistance(string qx, string qy, string qz)
+    {
+        var ox = Let(Max(qx, Zero));
+        var oy = Let(Max(qy, Zero));
+        var oz = Let(Max(qz, Zero));
+        var inside = Min(Max(qx, Max(qy, qz)), Zero);
+        return Add(Length(ox, oy, oz), inside);
+    }
+
+    private static string RepeatAxis(string p, double spacing, double count) =>
+        spacing == 0
+            ? p
+            : Sub(p, Mul(C(spacing), $"{MathType}.Round({MathType}.Clamp({Div(p, C(spacing))}, {C(-count)}, {C(count)}))"));
+}
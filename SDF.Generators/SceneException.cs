@@ -0,0 +1,21 @@
+using System;
+using Microsoft.CodeAnalysis;
+
+namespace SDF.Generators;
+
+/// <summary>
+/// Raised when a scene uses something that cannot be evaluated at build time
+/// </summary>
+internal sealed class SceneException : Exception
+{
+    public SceneException(SyntaxNode syntax, string message)
+        : base(message)
+    {
+        Syntax = syntax;
+    }
+
+    /// <summary>
+    /// Source the message refers to
+    /// </summary>
+    public SyntaxNode Syntax { get; }
+}
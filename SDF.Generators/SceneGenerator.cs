@@ -0,0 +1,160 @@
+using System;
+using System.Linq;
+using System.Text;
+using System.Threading;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using Microsoft.CodeAnalysis.CSharp.Syntax;
+using Microsoft.CodeAnalysis.Operations;
+
+namespace SDF.Generators;
+
+/// <summary>
+/// Generates kernels for scenes fixed at build time. For every static,
+/// parameterless method returning <c>SDF3</c> marked <c>[SdfScene]</c>, the
+/// tree it builds is evaluated during compilation and written out as
+/// straight-line C#: <c>{Name}Kernel(x, y, z)</c> computes the distance with
+/// every argument a literal, and <c>{Name}Compiled()</c> returns the scene
+/// with that kernel attached, ready for <c>MeshGenerator</c>. Scenes using
+/// anything the generator cannot evaluate still get <c>{Name}Compiled()</c>,
+/// compiled at run time, and a warning saying why.
+/// </summary>
+[Generator(LanguageNames.CSharp)]
+public sealed class SceneGenerator : IIncrementalGenerator
+{
+    private const string AttributeName = "SDF.SdfSceneAttribute";
+
+    private static readonly DiagnosticDescriptor NotSpecialized = new(
+        "SDF001", "Scene cannot be specialized at build time",
+        "Scene is compiled at run time instead: {0}", "SDF.Generators", DiagnosticSeverity.Warning, true);
+
+    private static readonly DiagnosticDescriptor InvalidScene = new(
+        "SDF002", "Invalid scene method", "{0}", "SDF.Generators", DiagnosticSeverity.Error, true);
+
+    public void Initialize(IncrementalGeneratorInitializationContext context)
+    {
+        var scenes = context.SyntaxProvider.ForAttributeWithMetadataName(AttributeName,
+            static (node, _) => node is MethodDeclarationSyntax,
+            static (context, cancellationToken) => Generate(context, cancellationToken));
+
+        context.RegisterSourceOutput(scenes, static (context, scene) =>
+        {
+            if (scene.ToDiagnostic() is { } diagnostic)
+                context.ReportDiagnostic(diagnostic);
+            if (scene.Source != null)
+                context.AddSource(scene.HintName, scene.Source);
+        });
+    }
+
+    private static SceneOutput Generate(GeneratorAttributeSyntaxContext context, CancellationToken cancellationToken)
+    {
+        var method = (IMethodSymbol)context.TargetSymbol;
+        var syntax = (MethodDeclarationSyntax)context.TargetNode;
+        var type = method.ContainingType;
+        var hintName = new string($"{type.ToDisplayString()}.{method.Name}.g.cs"
+            .Select(c => char.IsLetterOrDigit(c) || c == '.' || c == '_' ? c : '_').ToArray());
+
+        if (!method.IsStatic || method.Parameters.Length != 0 || method.IsGenericMethod
+            || method.ReturnType.ToDisplayString() != "SDF.SDF3")
+        {
+            return new SceneOutput(hintName, null, InvalidScene,
+                $"Scene method '{method.Name}' must be static, parameterless and return SDF3", syntax.Identifier.GetLocation());
+        }
+        for (var t = type; t != null; t = t.ContainingType)
+        {
+            if (t.IsGenericType || !t.DeclaringSyntaxReferences.Any(r =>
+                    r.GetSyntax(cancellationToken) is TypeDeclarationSyntax d && d.Modifiers.Any(SyntaxKind.PartialKeyword)))
+            {
+                return new SceneOutput(hintName, null, InvalidScene,
+                    $"Type '{t.Name}' declaring scene method '{method.Name}' must be partial and not generic", syntax.Identifier.GetLocation());
+            }
+        }
+
+        var depth = method.ContainingNamespace.IsGlobalNamespace ? 1 : 2;
+        for (var t = type; t != null; t = t.ContainingType)
+            depth++;
+        var indent = new string(' ', 4 * depth);
+
+        try
+        {
+            var body = context.SemanticModel.GetOperation(syntax, cancellationToken) as IMethodBodyOperation
+                ?? throw new SceneException(syntax, "the scene method has no body");
+            var kernel = KernelWriter.Write(SceneInterpreter.Run(body), indent);
+            return new SceneOutput(hintName, Render(method, kernel));
+        }
+        catch (SceneException e)
+        {
+            return new SceneOutput(hintName, Render(method, null), NotSpecialized, e.Message, e.Syntax.GetLocation());
+        }
+    }
+
+    /// <summary>
+    /// Source declaring the kernel and the compiled scene inside the scene's
+    /// partial types; without a kernel the scene is compiled at run time
+    /// </summary>
+    private static string Render(IMethodSymbol method, string? kernel)
+    {
+        var types = Enumerable.Empty<INamedTypeSymbol>();
+        for (var t = method.ContainingType; t != null; t = t.ContainingType)
+            types = types.Prepend(t);
+
+        var text = new StringBuilder();
+        text.Append("// <auto-generated/>\n#nullable enable\n\n");
+        var ns = method.ContainingNamespace;
+        var indent = "";
+        if (!ns.IsGlobalNamespace)
+        {
+            text.Append("namespace ").Append(ns.ToDisplayString()).Append("\n{\n");
+            indent = "    ";
+        }
+        foreach (var type in types)
+        {
+            text.Append(indent).Append("partial ").Append(Keyword(type)).Append(' ').Append(type.Name).Append('\n');
+            text.Append(indent).Append("{\n");
+            indent += "    ";
+        }
+
+        var name = method.Name;
+        var access = SyntaxFacts.GetText(method.DeclaredAccessibility);
+        if (kernel != null)
+        {
+            text.Append(indent).Append("/// <summary>\n");
+            text.Append(indent).Append($"/// Distance to the <see cref=\"{name}\"/> scene, specialized at build time\n");
+            text.Append(indent).Append("/// </summary>\n");
+            // Optimized on first call: tier-0 code would run the first batches several times slower
+            text.Append(indent).Append("[global::System.Runtime.CompilerServices.MethodImpl(global::System.Runtime.CompilerServices.MethodImplOptions.AggressiveOptimization)]\n");
+            text.Append(indent).Append($"{access} static double {name}Kernel(double x, double y, double z)\n");
+            text.Append(indent).Append("{\n");
+            text.Append(kernel);
+            text.Append(indent).Append("}\n\n");
+            text.Append(indent).Append("/// <summary>\n");
+            text.Append(indent).Append($"/// The <see cref=\"{name}\"/> scene evaluated through <see cref=\"{name}Kernel\"/>\n");
+            text.Append(indent).Append("/// </summary>\n");
+            text.Append(indent).Append($"{access} static global::SDF.SDF3 {name}Compiled() => {name}().WithKernel({name}Kernel);\n");
+        }
+        else
+        {
+            text.Append(indent).Append("/// <summary>\n");
+            text.Append(indent).Append($"/// The <see cref=\"{name}\"/> scene, compiled at run time as it could not be specialized\n");
+            text.Append(indent).Append("/// </summary>\n");
+            text.Append(indent).Append($"{access} static global::SDF.SDF3 {name}Compiled() => {name}().Compile();\n");
+        }
+
+        while (indent.Length > 0)
+        {
+            indent = indent.Substring(4);
+            text.Append(indent).Append("}\n");
+        }
+        return text.ToString();
+    }
+
+    private static string Keyword(INamedTypeSymbol type) =>
+        (type.IsRecord, type.TypeKind) switch
+        {
+            (true, TypeKind.Struct) => "record struct",
+            (true, _) => "record",
+            (_, TypeKind.Struct) => "struct",
+            (_, TypeKind.Interface) => "interface",
+            _ => "class",
+        };
+}
@@ -0,0 +1,365 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Linq;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.Operations;
+
+namespace SDF.Generators;
+
+/// <summary>
+/// Evaluates the body of a scene method at build time, following the calls to
+/// Primitives and Operations to the tree they would build. Values are doubles,
+/// <see cref="SceneVector"/>s, <see cref="SceneNode"/>s or null; anything
+/// else, such as a loop or a call into other code, raises a <see cref="SceneException"/>.
+/// </summary>
+internal sealed class SceneInterpreter
+{
+    private readonly Dictionary<ILocalSymbol, object?> _locals = new(SymbolEqualityComparer.Default);
+
+    /// <summary>
+    /// Tree returned by a scene method
+    /// </summary>
+    public static SceneNode Run(IMethodBodyOperation body)
+    {
+        var block = body.BlockBody ?? body.ExpressionBody
+            ?? throw new SceneException(body.Syntax, "the scene method has no body");
+        return new SceneInterpreter().Run(block);
+    }
+
+    private SceneNode Run(IBlockOperation block)
+    {
+        foreach (var operation in block.Operations)
+        {
+            switch (operation)
+            {
+                case IVariableDeclarationGroupOperation group:
+                    foreach (var declarator in group.Declarations.SelectMany(d => d.Declarators))
+                    {
+                        var initializer = declarator.GetVariableInitializer()
+                            ?? throw new SceneException(declarator.Syntax, $"'{declarator.Symbol.Name}' has no initializer");
+                        _locals[declarator.Symbol] = Value(initializer.Value);
+                    }
+                    break;
+                case IExpressionStatementOperation { Operation: ISimpleAssignmentOperation { Target: ILocalReferenceOperation local } assignment }:
+                    _locals[local.Local] = Value(assignment.Value);
+                    break;
+                case IExpressionStatementOperation { Operation: ICompoundAssignmentOperation { Target: ILocalReferenceOperation local } compound }:
+                    _locals[local.Local] = Binary(compound.OperatorKind, Value(local), Value(compound.Value), compound.Syntax);
+                    break;
+                case IExpressionStatementOperation statement:
+                    Value(statement.Operation);
+                    break;
+                case IReturnOperation { ReturnedValue: { } returned }:
+                    return Node(Value(returned), returned.Syntax);
+                default:
+                    throw new SceneException(operation.Syntax, "only local variables, assignments and a return are supported");
+            }
+        }
+        throw new SceneException(block.Syntax, "the scene method does not return a tree");
+    }
+
+    private object? Value(IOperation operation)
+    {
+        if (operation.ConstantValue.HasValue)
+        {
+            return operation.ConstantValue.Value switch
+            {
+                null => null,
+                bool or string or char => throw new SceneException(operation.Syntax, "only numeric constants are supported"),
+                var number => Convert.ToDouble(number, CultureInfo.InvariantCulture),
+            };
+        }
+
+        switch (operation)
+        {
+            case IConversionOperation conversion:
+            {
+                // Casts to float round, as in Slab
+                var value = Value(conversion.Operand);
+                return conversion.Type?.SpecialType == SpecialType.System_Single && value is double d ? (double)(float)d : value;
+            }
+            case ILocalReferenceOperation local:
+                return _locals.TryGetValue(local.Local, out var stored)
+                    ? stored
+                    : throw new SceneException(operation.Syntax, $"'{local.Local.Name}' is not assigned yet");
+            case IFieldReferenceOperation { Instance: null } field:
+                return Field(field);
+            case IPropertyReferenceOperation { Instance: not null } property:
+            {
+                var v = Value(property.Instance!) as SceneVector? ?? throw new SceneException(operation.Syntax, "expected a vector");
+                return property.Property.Name switch
+                {
+                    "X" => v.X,
+                    "Y" => v.Y,
+                    "Z" => v.Z,
+                    _ => throw new SceneException(operation.Syntax, $"unsupported member '{property.Property.Name}'"),
+                };
+            }
+            case IObjectCreationOperation { Initializer: null, Arguments.Length: 3 } creation when IsType(creation.Type, "SDF.Vector3"):
+                return new SceneVector(
+                    Number(creation.Arguments[0].Value),
+                    Number(creation.Arguments[1].Value),
+                    Number(creation.Arguments[2].Value));
+            case IUnaryOperation { OperatorKind: UnaryOperatorKind.Minus or UnaryOperatorKind.Plus } unary:
+            {
+                var value = Value(unary.Operand);
+                var minus = unary.OperatorKind == UnaryOperatorKind.Minus;
+                return value switch
+                {
+                    double d => minus ? -d : d,
+                    SceneVector v => minus ? -v : v,
+                    _ => throw new SceneException(operation.Syntax, "unsupported operand"),
+                };
+            }
+            case IBinaryOperation binary:
+                return Binary(binary.OperatorKind, Value(binary.LeftOperand), Value(binary.RightOperand), binary.Syntax);
+            case IInvocationOperation invocation:
+                return Call(invocation);
+            case IDefaultValueOperation:
+                return null;
+            default:
+                throw new SceneException(operation.Syntax, $"'{operation.Syntax}' cannot be evaluated at build time");
+        }
+    }
+
+    private static object Binary(BinaryOperatorKind kind, object? left, object? right, SyntaxNode syntax)
+    {
+        switch (left, right, kind)
+        {
+            case (SceneNode a, SceneNode b, BinaryOperatorKind.Or):
+                return Boolean("Union", a, b, null);
+            case (SceneNode a, SceneNode b, BinaryOperatorKind.And):
+                return Boolean("Intersection", a, b, null);
+            case (SceneNode a, SceneNode b, BinaryOperatorKind.Subtract):
+                return Boolean("Difference", a, b, null);
+
+            case (SceneVector a, SceneVector b, BinaryOperatorKind.Add):
+                return a + b;
+            case (SceneVector a, SceneVector b, BinaryOperatorKind.Subtract):
+                return a - b;
+            case (SceneVector a, double s, BinaryOperatorKind.Multiply):
+                return a * s;
+            case (double s, SceneVector a, BinaryOperatorKind.Multiply):
+                return a * s;
+            case (SceneVector a, double s, BinaryOperatorKind.Divide):
+                return Math.Abs(s) < double.Epsilon ? throw new SceneException(syntax, "division of a vector by zero") : a / s;
+
+            case (double a, double b, BinaryOperatorKind.Add):
+                return a + b;
+            case (double a, double b, BinaryOperatorKind.Subtract):
+                return a - b;
+            case (double a, double b, BinaryOperatorKind.Multiply):
+                return a * b;
+            case (double a, double b, BinaryOperatorKind.Divide):
+                return a / b;
+            case (double a, double b, BinaryOperatorKind.Remainder):
+                return a % b;
+
+            default:
+                throw new SceneException(syntax, $"unsupported operator {kind}");
+        }
+    }
+
+    private static object Field(IFieldReferenceOperation operation)
+    {
+        var field = operation.Field;
+        var type = field.ContainingType.ToDisplayString();
+        return (type, field.Name) switch
+        {
+            ("SDF.Constants", "Origin") => SceneVector.Zero,
+            ("SDF.Constants", "X") => SceneVector.UnitX,
+            ("SDF.Constants", "Y") => SceneVector.UnitY,
+            ("SDF.Constants", "Z" or "Up") => SceneVector.UnitZ,
+            ("SDF.Vector3", "Zero") => SceneVector.Zero,
+            ("SDF.Vector3", "One") => SceneVector.One,
+            ("SDF.Vector3", "UnitX") => SceneVector.UnitX,
+            ("SDF.Vector3", "UnitY") => SceneVector.UnitY,
+            ("SDF.Vector3", "UnitZ") => SceneVector.UnitZ,
+            _ => throw new SceneException(operation.Syntax, $"field '{field.ToDisplayString()}' cannot be read at build time"),
+        };
+    }
+
+    private object? Call(IInvocationOperation invocation)
+    {
+        var method = invocation.TargetMethod;
+        var type = method.ContainingType.ToDisplayString();
+        var args = invocation.Arguments.ToDictionary(a => a.Parameter!.Name, a => a.Value);
+
+        object? Arg(string name) => args.TryGetValue(name, out var value) ? Value(value) : null;
+        double D(string name) => Arg(name) as double? ?? throw Missing(name);
+        double? OptionalD(string name) => Arg(name) as double?;
+        SceneVector V(string name) => Arg(name) as SceneVector? ?? throw Missing(name);
+        SceneVector? OptionalV(string name) => Arg(name) as SceneVector?;
+        SceneNode N(string name) => Node(Arg(name), args.TryGetValue(name, out var value) ? value.Syntax : invocation.Syntax);
+        SceneException Missing(string name) => new(invocation.Syntax, $"argument '{name}' of {method.Name} is not a constant");
+
+        switch (type, method.Name)
+        {
+            case ("SDF.Primitives", "Sphere"):
+            {
+                var c = OptionalV("center") ?? SceneVector.Zero;
+                return new SceneNode("Sphere", new[] { D("radius"), c.X, c.Y, c.Z });
+            }
+            case ("SDF.Primitives", "Box"):
+            {
+                var size = method.Parameters[0].Type.SpecialType == SpecialType.System_Double
+                    ? new SceneVector(D("size"), D("size"), D("size"))
+                    : V("size");
+                var c = OptionalV("center") ?? SceneVector.Zero;
+                return new SceneNode("Box", new[] { size.X, size.Y, size.Z, c.X, c.Y, c.Z });
+            }
+            case ("SDF.Primitives", "Cylinder"):
+                return new SceneNode("Cylinder", new[] { D("radius") });
+            case ("SDF.Primitives", "CappedCylinder" or "Capsule"):
+            {
+                var a = V("a");
+                var b = V("b");
+                return new SceneNode(method.Name, new[] { a.X, a.Y, a.Z, b.X, b.Y, b.Z, D("radius") });
+            }
+            case ("SDF.Primitives", "Plane"):
+                return Plane(OptionalV("normal") ?? SceneVector.UnitZ, OptionalV("point") ?? SceneVector.Zero);
+            case ("SDF.Primitives", "Torus"):
+                return new SceneNode("Torus", new[] { D("r1"), D("r2") });
+            case ("SDF.Primitives", "RoundedBox"):
+            {
+                var size = V("size");
+                return new SceneNode("RoundedBox", new[] { size.X, size.Y, size.Z, D("radius") });
+            }
+            case ("SDF.Primitives", "Slab"):
+            {
+                var planes = new List<SceneNode>();
+                if (OptionalD("x0") is { } x0) planes.Add(Plane(SceneVector.UnitX, new SceneVector((float)x0, 0, 0)));
+                if (OptionalD("x1") is { } x1) planes.Add(Plane(-SceneVector.UnitX, new SceneVector((float)x1, 0, 0)));
+                if (OptionalD("y0") is { } y0) planes.Add(Plane(SceneVector.UnitY, new SceneVector(0, (float)y0, 0)));
+                if (OptionalD("y1") is { } y1) planes.Add(Plane(-SceneVector.UnitY, new SceneVector(0, (float)y1, 0)));
+                if (OptionalD("z0") is { } z0) planes.Add(Plane(SceneVector.UnitZ, new SceneVector(0, 0, (float)z0)));
+                if (OptionalD("z1") is { } z1) planes.Add(Plane(-SceneVector.UnitZ, new SceneVector(0, 0, (float)z1)));
+                if (planes.Count == 0)
+                    throw new SceneException(invocation.Syntax, "at least one plane must be specified");
+                return planes.Skip(1).Aggregate(planes[0], (result, plane) => Boolean("Intersection", result, plane, null));
+            }
+            case ("SDF.Primitives", "Ellipsoid"):
+            {
+                var size = V("size");
+                return new SceneNode("Ellipsoid", new[] { size.X, size.Y, size.Z });
+            }
+
+            case ("SDF.Operations", "Union" or "Difference" or "Intersection"):
+                if (!args.ContainsKey("a"))
+                    throw new SceneException(invocation.Syntax, "n-ary unions are not supported");
+                return Boolean(method.Name, N("a"), N("b"), OptionalD("k"));
+            case ("SDF.Operations", "SmoothUnion" or "SmoothDifference" or "SmoothIntersection"):
+                return new SceneNode(method.Name, new[] { D("k") }, N("a"), N("b"));
+            case ("SDF.Operations", "Translate"):
+            {
+                var offset = V("offset");
+                return new SceneNode("Translate", new[] { offset.X, offset.Y, offset.Z }, N("sdf"));
+            }
+            case ("SDF.Operations", "Scale"):
+                return new SceneNode("Scale", new[] { D("factor") }, N("sdf"));
+            case ("SDF.Operations", "Rotate"):
+                return Rotate(N("sdf"), D("angle"), OptionalV("axis") ?? SceneVector.UnitZ);
+            case ("SDF.Operations", "Orient"):
+            {
+                var sdf = N("sdf");
+                var normalized = V("direction").Normalize();
+                var z = SceneVector.UnitZ;
+                if (Math.Abs(SceneVector.Dot(normalized, z) - 1.0f) < 0.0001f)
+                    return sdf;
+                if (Math.Abs(SceneVector.Dot(normalized, z) + 1.0f) < 0.0001f)
+                    return Rotate(sdf, Math.PI, SceneVector.UnitX);
+                var axis = SceneVector.Cross(z, normalized).Normalize();
+                return Rotate(sdf, Math.Acos(SceneVector.Dot(z, normalized)), axis);
+            }
+            case ("SDF.Operations", "Twist" or "Bend"):
+                return new SceneNode(method.Name, new[] { D("k") }, N("sdf"));
+            case ("SDF.Operations", "Elongate"):
+            {
+                var size = V("size");
+                return new SceneNode("Elongate", new[] { size.X, size.Y, size.Z }, N("sdf"));
+            }
+            case ("SDF.Operations", "Dilate" or "Erode"):
+                return new SceneNode(method.Name, new[] { D("r") }, N("sdf"));
+            case ("SDF.Operations", "Shell"):
+                return new SceneNode("Shell", new[] { D("thickness") }, N("sdf"));
+            case ("SDF.Operations", "Repeat"):
+            {
+                // Padded repeats cull neighbor cells through a table built at run time
+                if ((OptionalD("padding") ?? 0) != 0)
+                    throw new SceneException(invocation.Syntax, "padded repeats are not supported");
+                var spacing = V("spacing");
+                var count = OptionalV("count") ?? new SceneVector(double.PositiveInfinity, double.PositiveInfinity, double.PositiveInfinity);
+                return new SceneNode("Repeat", new[] { spacing.X, spacing.Y, spacing.Z, count.X, count.Y, count.Z, 0 }, N("sdf"));
+            }
+
+            case ("SDF.SDF3", "K"):
+            {
+                var node = Node(Value(invocation.Instance!), invocation.Syntax);
+                node.SmoothingK = D("k");
+                return node;
+            }
+
+            case ("SDF.Constants", "Radians"):
+                return D("degrees") * Math.PI / 180.0;
+            case ("SDF.Constants", "Degrees"):
+                return D("radians") * 180.0 / Math.PI;
+
+            case ("SDF.Vector3", "Normalize"):
+                return (invocation.Instance is { } v ? Value(v) as SceneVector? : V("v"))?.Normalize()
+                    ?? throw Missing("v");
+            case ("SDF.Vector3", "Cross"):
+                return SceneVector.Cross(V("a"), V("b"));
+            case ("SDF.Vector3", "Dot"):
+                return SceneVector.Dot(V("a"), V("b"));
+
+            case ("System.Math", _) when method.Parameters.All(p => p.Type.SpecialType == SpecialType.System_Double):
+            {
+                var values = method.Parameters.Select(p => D(p.Name)).ToArray();
+                return (method.Name, values.Length) switch
+                {
+                    ("Sqrt", 1) => Math.Sqrt(values[0]),
+                    ("Sin", 1) => Math.Sin(values[0]),
+                    ("Cos", 1) => Math.Cos(values[0]),
+                    ("Tan", 1) => Math.Tan(values[0]),
+                    ("Abs", 1) => Math.Abs(values[0]),
+                    ("Pow", 2) => Math.Pow(values[0], values[1]),
+                    ("Min", 2) => Math.Min(values[0], values[1]),
+                    ("Max", 2) => Math.Max(values[0], values[1]),
+                    _ => throw new SceneException(invocation.Syntax, $"'Math.{method.Name}' is not supported"),
+                };
+            }
+
+            default:
+                throw new SceneException(invocation.Syntax, $"calls to '{method.ToDisplayString()}' cannot be evaluated at build time");
+        }
+    }
+
+    private static SceneNode Boolean(string name, SceneNode a, SceneNode b, double? k)
+    {
+        k ??= b.SmoothingK ?? a.SmoothingK;
+        return k is > 0
+            ? new SceneNode("Smooth" + name, new[] { k.Value }, a, b)
+            : new SceneNode(name, Array.Empty<double>(), a, b);
+    }
+
+    private static SceneNode Plane(SceneVector normal, SceneVector point)
+    {
+        var n = normal.Normalize();
+        return new SceneNode("Plane", new[] { n.X, n.Y, n.Z, point.X, point.Y, point.Z });
+    }
+
+    private static SceneNode Rotate(SceneNode sdf, double angle, SceneVector axis)
+    {
+        var normalized = axis.Normalize();
+        return new SceneNode("Rotate", new[] { angle, normalized.X, normalized.Y, normalized.Z }, sdf);
+    }
+
+    private double Number(IOperation operation) =>
+        Value(operation) as double? ?? throw new SceneException(operation.Syntax, "expected a number");
+
+    private static SceneNode Node(object? value, SyntaxNode syntax) =>
+        value as SceneNode ?? throw new SceneException(syntax, "expected an SDF3 tree");
+
+    private static bool IsType(ITypeSymbol? type, string name) => type?.ToDisplayString() == name;
+}
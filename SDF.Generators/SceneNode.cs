@@ -0,0 +1,29 @@
+namespace SDF.Generators;
+
+/// <summary>
+/// Node of a scene evaluated at build time, with the kind and argument layout
+/// of the <c>SDF3</c> node the library would build for the same calls
+/// </summary>
+internal sealed class SceneNode
+{
+    public SceneNode(string kind, double[] args, params SceneNode[] inputs)
+    {
+        Kind = kind;
+        Args = args;
+        Inputs = inputs;
+    }
+
+    /// <summary>
+    /// Name of the matching <c>SdfNodeKind</c>
+    /// </summary>
+    public string Kind { get; }
+
+    public double[] Args { get; }
+
+    public SceneNode[] Inputs { get; }
+
+    /// <summary>
+    /// Smoothing factor set with <c>SDF3.K</c>, read by the boolean operators
+    /// </summary>
+    public double? SmoothingK { get; set; }
+}
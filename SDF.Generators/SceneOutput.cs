@@ -0,0 +1,49 @@
+using System;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.Text;
+
+namespace SDF.Generators;
+
+/// <summary>
+/// What the generator produces for one scene method: the source file and a
+/// diagnostic when the scene could not be specialized. Holds only values, so
+/// the incremental pipeline can tell when a scene's output is unchanged.
+/// </summary>
+internal sealed class SceneOutput : IEquatable<SceneOutput>
+{
+    public SceneOutput(string hintName, string? source, DiagnosticDescriptor? descriptor = null,
+        string? message = null, Location? location = null)
+    {
+        HintName = hintName;
+        Source = source;
+        Descriptor = descriptor;
+        Message = message;
+        if (location?.SourceTree != null)
+        {
+            FilePath = location.SourceTree.FilePath;
+            Span = location.SourceSpan;
+            LineSpan = location.GetLineSpan().Span;
+        }
+    }
+
+    public string HintName { get; }
+    public string? Source { get; }
+    public DiagnosticDescriptor? Descriptor { get; }
+    public string? Message { get; }
+    public string? FilePath { get; }
+    public TextSpan Span { get; }
+    public LinePositionSpan LineSpan { get; }
+
+    public Diagnostic? ToDiagnostic() =>
+        Descriptor == null
+            ? null
+            : Diagnostic.Create(Descriptor, FilePath == null ? Location.None : Location.Create(FilePath, Span, LineSpan), Message);
+
+    public bool Equals(SceneOutput? other) =>
+        other != null && HintName == other.HintName && Source == other.Source && Descriptor?.Id == other.Descriptor?.Id
+        && Message == other.Message && FilePath == other.FilePath && Span == other.Span && LineSpan == other.LineSpan;
+
+    public override bool Equals(object? obj) => Equals(obj as SceneOutput);
+
+    public override int GetHashCode() => (HintName, Source, Message, FilePath, Span).GetHashCode();
+}
@@ -0,0 +1,45 @@
+using System;
+
+namespace SDF.Generators;
+
+/// <summary>
+/// Build-time counterpart of <c>SDF.Vector3</c>
+/// </summary>
+internal readonly struct SceneVector
+{
+    public SceneVector(double x, double y, double z)
+    {
+        X = x;
+        Y = y;
+        Z = z;
+    }
+
+    public double X { get; }
+    public double Y { get; }
+    public double Z { get; }
+
+    public static readonly SceneVector Zero = new(0, 0, 0);
+    public static readonly SceneVector One = new(1, 1, 1);
+    public static readonly SceneVector UnitX = new(1, 0, 0);
+    public static readonly SceneVector UnitY = new(0, 1, 0);
+    public static readonly SceneVector UnitZ = new(0, 0, 1);
+
+    public static SceneVector operator +(SceneVector a, SceneVector b) => new(a.X + b.X, a.Y + b.Y, a.Z + b.Z);
+    public static SceneVector operator -(SceneVector a, SceneVector b) => new(a.X - b.X, a.Y - b.Y, a.Z - b.Z);
+    public static SceneVector operator -(SceneVector a) => new(-a.X, -a.Y, -a.Z);
+    public static SceneVector operator *(SceneVector a, double s) => new(a.X * s, a.Y * s, a.Z * s);
+    public static SceneVector operator /(SceneVector a, double s) => new(a.X / s, a.Y / s, a.Z / s);
+
+    public double Length() => Math.Sqrt(X * X + Y * Y + Z * Z);
+
+    public SceneVector Normalize()
+    {
+        var length = Length();
+        return length > 0 ? this / length : Zero;
+    }
+
+    public static double Dot(SceneVector a, SceneVector b) => a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+
+    public static SceneVector Cross(SceneVector a, SceneVector b) =>
+        new(a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X);
+}
@@ -1,4 +1,5 @@
 import itertools
+import threading
 import numpy as np
 
 _min = np.minimum
@@ -79,6 +80,27 @@ def shell(other, thickness):
         return np.abs(other(p)) - thickness / 2
     return f
 
+def _estimate_bounds(sdf, dim):
+    # Same search as core._estimate_bounds, in any number of dimensions
+    s = 16
+    lo = np.full(dim, -1e9)
+    hi = np.full(dim, 1e9)
+    prev = None
+    for i in range(32):
+        axes = [np.linspace(lo[j], hi[j], s) for j in range(dim)]
+        d = (hi - lo) / (s - 1)
+        threshold = np.linalg.norm(d) / 2
+        if threshold == prev:
+            break
+        prev = threshold
+        P = np.stack(np.meshgrid(*axes, indexing='ij'), axis=-1).reshape(-1, dim)
+        volume = sdf(P).reshape((s,) * dim)
+        where = np.argwhere(np.abs(volume) <= threshold)
+        if len(where) == 0:
+            return None
+        lo, hi = lo + where.min(axis=0) * d - d / 2, lo + where.max(axis=0) * d + d / 2
+    return lo, hi
+
 def repeat(other, spacing, count=None, padding=0):
     count = np.array(count) if count is not None else None
     spacing = np.array(spacing)
@@ -98,17 +120,47 @@ def repeat(other, spacing, count=None, padding=0):
         axes = [list(range(-p, p + 1)) for p in padding]
         return list(itertools.product(*axes))
 
+    # The home cell is evaluated everywhere; each neighbor, nearest first, only
+    # where the child's bounding box placed in that cell can beat the best so far.
+    # f is called from a thread pool, so the neighbors and bounds are built
+    # under a lock into locals and published together, once complete.
+    plan = None
+    lock = threading.Lock()
+
+    def prepare(dim):
+        nonlocal plan
+        with lock:
+            if plan is None:
+                offsets = [np.array(n) for n in neighbors(dim, padding, spacing) if any(n)]
+                offsets.sort(key=lambda n: np.linalg.norm(n * spacing))
+                bounds = _estimate_bounds(other, dim) if offsets else None
+                plan = (offsets, bounds)
+        return plan
+
     def f(p):
+        dim = p.shape[-1]
+        offsets, bounds = plan or prepare(dim)
+
         q = np.divide(p, spacing, out=np.zeros_like(p), where=spacing != 0)
         if count is None:
             index = np.round(q)
         else:
             index = np.clip(np.round(q), -count, count)
 
-        indexes = [index + n for n in neighbors(p.shape[-1], padding, spacing)]
-        A = [other(p - spacing * i) for i in indexes]
-        a = A[0]
-        for b in A[1:]:
-            a = _min(a, b)
-        return a
+        a = other(p - spacing * index)
+        shape = a.shape
+        a = a.reshape(-1).copy()
+        for n in offsets:
+            i = index + n
+            r = p - spacing * i
+            visit = np.ones(len(p), dtype=bool)
+            if count is not None:
+                visit &= np.all(np.abs(i) <= count, axis=-1)
+            if bounds is not None:
+                lo, hi = bounds
+                distance = np.linalg.norm(_max(_max(lo - r, r - hi), 0), axis=-1)
+                visit &= (distance <= 0) | (distance < a)
+            if np.any(visit):
+                a[visit] = _min(a[visit], other(r[visit]).reshape(-1))
+        return a.reshape(shape)
     return f